@@ -2,6 +2,8 @@
 
 #ifdef TOOLS_ENABLED
 
+#include "../julia_language.h"
+
 #include "core/core_constants.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
@@ -48,6 +50,46 @@ static String fix_doc_description(const String &p_bbcode) {
 			.strip_edges();
 }
 
+// Engine methods which can block or run for a long time. They are called in a GC-safe region (see Godot.ptrcall_gc_safe), so that
+// other Julia threads don't have to wait for them to finish before collecting garbage.
+static const char *gc_safe_methods[][2] = {
+	{ "CharacterBody2D", "move_and_slide" },
+	{ "CharacterBody3D", "move_and_slide" },
+	{ "DirAccess", "copy" },
+	{ "DirAccess", "make_dir_recursive" },
+	{ "DirAccess", "rename" },
+	{ "FileAccess", "flush" },
+	{ "FileAccess", "get_as_text" },
+	{ "FileAccess", "get_buffer" },
+	{ "FileAccess", "store_buffer" },
+	{ "HTTPClient", "poll" },
+	{ "Image", "compress" },
+	{ "Image", "generate_mipmaps" },
+	{ "Image", "resize" },
+	{ "Image", "save_exr" },
+	{ "Image", "save_jpg" },
+	{ "Image", "save_png" },
+	{ "Image", "save_webp" },
+	{ "Mutex", "lock" },
+	{ "OS", "delay_msec" },
+	{ "OS", "delay_usec" },
+	{ "Semaphore", "wait" },
+	{ "StreamPeerTCP", "poll" },
+	{ "Thread", "wait_to_finish" },
+	{ "WorkerThreadPool", "wait_for_group_task_completion" },
+	{ "WorkerThreadPool", "wait_for_task_completion" },
+	{ nullptr, nullptr }
+};
+
+static bool _is_gc_safe_method(const StringName &p_class_name, const StringName &p_method_name) {
+	for (int i = 0; gc_safe_methods[i][0]; i++) {
+		if (p_class_name == gc_safe_methods[i][0] && p_method_name == gc_safe_methods[i][1]) {
+			return true;
+		}
+	}
+	return false;
+}
+
 static StringName _get_int_type_name_from_meta(GodotTypeInfo::Metadata p_meta) {
 	switch (p_meta) {
 		case GodotTypeInfo::METADATA_INT_IS_INT8:
@@ -132,7 +174,7 @@ bool BindingsGenerator::_arg_default_value_from_variant(const Variant &p_val, Bi
 			r_arg.julia_default_value = vformat("GodotString(\"%s\")", r_arg.julia_default_value);
 		} break;
 		case Variant::STRING_NAME: {
-			r_arg.julia_default_value = vformat("StringName(GodotString(\"%s\"))", r_arg.julia_default_value);
+			r_arg.julia_default_value = vformat("sn\"%s\"", r_arg.julia_default_value);
 		} break;
 		// Struct types.
 		case Variant::VECTOR2: {
@@ -171,6 +213,20 @@ bool BindingsGenerator::_arg_default_value_from_variant(const Variant &p_val, Bi
 			Vector4i v = p_val;
 			r_arg.julia_default_value = vformat("Vector4i(%d, %d, %d, %d)", v.x, v.y, v.z, v.w);
 		} break;
+		// Packed array types.
+		case Variant::PACKED_BYTE_ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_VECTOR2_ARRAY:
+		case Variant::PACKED_VECTOR3_ARRAY:
+		case Variant::PACKED_COLOR_ARRAY:
+		case Variant::PACKED_VECTOR4_ARRAY: {
+			// NOTE: The default values of packed array arguments are empty.
+			ERR_FAIL_COND_V_MSG(!p_val.is_zero(), false, "Unexpected non-empty packed array in argument.");
+			r_arg.julia_default_value = vformat("%s()", Variant::get_type_name(p_val.get_type()));
+		} break;
 		// TODO: Handle more complex types.
 		default: {
 			ERR_FAIL_V_MSG(false, "Unexpected Variant type in argument: " + itos(p_val.get_type()));
@@ -279,7 +335,7 @@ void BindingsGenerator::_generate_julia_type(const GodotType &p_godot_type, Stri
 				fix_doc_description(p_godot_type.documentation->brief_description),
 				fix_doc_description(p_godot_type.documentation->description)));
 		p_output.append(vformat("module %s\n\n", p_godot_type.julia_name)); // TODO: Make it a baremodule instead?
-		p_output.append("using ..Godot: String, StringName, get_string_name!");
+		p_output.append("using ..Godot: String, StringName, @sn_str, ptrcall, ptrcall_gc_safe");
 		if (p_godot_type.is_singleton) {
 			p_output.append(vformat(", %sInstance", p_godot_type.julia_name));
 		}
@@ -293,12 +349,26 @@ void BindingsGenerator::_generate_julia_type(const GodotType &p_godot_type, Stri
 			p_output.append(vformat(", %s", dependency_name));
 		}
 		p_output.append("\n\n");
-		p_output.append(vformat("singleton = %sInstance(C_NULL)\n\n", p_godot_type.julia_name));
+		p_output.append(vformat("const singleton = Ref(%sInstance(C_NULL))\n\n", p_godot_type.julia_name));
+	}
+
+	// Method binds, resolved once by init_method_binds() when the package is loaded.
+	p_output.append(vformat("const method_binds_%s = fill(C_NULL, %d)\n\n", p_godot_type.julia_name, p_godot_type.methods.size()));
+	p_output.append(vformat("function init_method_binds_%s()\n", p_godot_type.julia_name));
+	if (p_godot_type.is_singleton) {
+		p_output.append(vformat("\tsingleton[] = %sInstance(@ccall godot_julia_get_singleton(sn\"%s\"::Ref{StringName})::Ptr{Nothing})\n", p_godot_type.julia_name, p_godot_type.name));
 	}
+	int method_bind_index = 1;
+	for (const GodotMethod &godot_method : p_godot_type.methods) {
+		p_output.append(vformat("\tmethod_binds_%s[%d] = @ccall godot_julia_get_method_bind(sn\"%s\"::Ref{StringName}, sn\"%s\"::Ref{StringName})::Ptr{Nothing}\n",
+				p_godot_type.julia_name, method_bind_index++, p_godot_type.name, godot_method.name));
+	}
+	p_output.append("end\n\n");
 
 	// Methods.
+	method_bind_index = 1;
 	for (const GodotMethod &godot_method : p_godot_type.methods) {
-		_generate_julia_method(p_godot_type, godot_method, p_output);
+		_generate_julia_method(p_godot_type, godot_method, method_bind_index++, p_output);
 	}
 
 	// Properties.
@@ -314,18 +384,12 @@ void BindingsGenerator::_generate_julia_type(const GodotType &p_godot_type, Stri
 	}
 }
 
-void BindingsGenerator::_generate_julia_method(const GodotType &p_godot_type, const GodotMethod &p_godot_method, StringBuilder &p_output) {
-	p_output.append("let\n");
-	p_output.append(vformat("\tglobal %s\n", p_godot_method.julia_name));
-	if (p_godot_type.is_singleton) {
-		p_output.append("\tglobal singleton\n");
-	}
-	p_output.append("\tmethod_bind = C_NULL\n");
+void BindingsGenerator::_generate_julia_method(const GodotType &p_godot_type, const GodotMethod &p_godot_method, int p_method_bind_index, StringBuilder &p_output) {
 	if (p_godot_method.documentation) {
-		p_output.append(vformat("\t@doc raw\"\"\"%s\"\"\"\n",
+		p_output.append(vformat("@doc raw\"\"\"%s\"\"\"\n",
 				fix_doc_description(p_godot_method.documentation->description)));
 	}
-	p_output.append(vformat("\tfunction %s(", p_godot_method.julia_name));
+	p_output.append(vformat("function %s(", p_godot_method.julia_name));
 	if (!p_godot_type.is_singleton) {
 		p_output.append(vformat("self::Godot%s", p_godot_type.julia_name));
 	}
@@ -342,116 +406,86 @@ void BindingsGenerator::_generate_julia_method(const GodotType &p_godot_type, co
 		}
 	}
 	p_output.append(")\n");
-	if (p_godot_type.is_singleton) {
-		p_output.append("\t\tglobal singleton\n");
-		p_output.append("\t\tif singleton.native_ptr == C_NULL\n");
-		p_output.append(vformat("\t\t\tsingleton = %sInstance(@ccall godot_julia_get_singleton(get_string_name!(:%s)::Ref{StringName})::Ptr{Nothing})\n", p_godot_type.julia_name, p_godot_type.name));
-		p_output.append("\t\tend\n");
-	}
-	p_output.append("\t\tif method_bind == C_NULL\n");
-	p_output.append(vformat("\t\t\tmethod_bind = @ccall godot_julia_get_method_bind(get_string_name!(:%s)::Ref{StringName}, get_string_name!(:%s)::Ref{StringName})::Ptr{Nothing}\n", p_godot_type.name, p_godot_method.name));
-	p_output.append("\t\tend\n");
-	String ret_ptrcall_typed;
-	const GodotType *return_type = nullptr;
-	if (p_godot_method.return_type.name == "Cvoid") {
-		ret_ptrcall_typed = "C_NULL::Ptr{Nothing}";
-	} else {
-		return_type = _get_type_or_null(p_godot_method.return_type);
+	p_output.append(vformat("\tmethod_bind = @inbounds method_binds_%s[%d]\n", p_godot_type.julia_name, p_method_bind_index));
+	// The arguments and the return value are converted by Godot.ptrcall, based on their Julia types.
+	String return_type_name = "Nothing";
+	if (p_godot_method.return_type.name != "Cvoid") {
+		const GodotType *return_type = _get_type_or_null(p_godot_method.return_type);
 		ERR_FAIL_NULL_MSG(return_type, vformat("Return type not found: %s", p_godot_method.return_type.name));
-
-		p_output.append(vformat("\t\tret = %s\n", return_type->ptrcall_initial));
-
-		ret_ptrcall_typed = vformat("ret::%s", return_type->ptrcall_type);
-	}
-	// TODO: Handle more return types.
-
-	// Handle arguments.
-	String args_ptrcall_typed;
-	if (argc == 0) {
-		args_ptrcall_typed = "C_NULL::Ptr{Nothing}";
-	} else {
-		p_output.append("\t\targs = [");
-		for (int i = 0; i < argc; i++) {
-			const GodotType *arg_type = _get_type_or_null(p_godot_method.arguments.get(i).type);
-			p_output.append(vformat(arg_type->ptrcall_input, p_godot_method.arguments.get(i).name));
-			if (i != argc - 1) {
-				p_output.append(", ");
-			}
+		return_type_name = return_type->julia_name;
+		if (return_type->is_singleton) {
+			return_type_name += JULIA_SINGLETON_INSTANCE_SUFFIX;
 		}
-		p_output.append("]\n");
-		args_ptrcall_typed = "args::Ref{Ptr{Nothing}}";
 	}
-	// TODO: Handle more complex argument types.
-
-	p_output.append("\t\t@ccall godot_julia_method_bind_ptrcall(method_bind::Ptr{Nothing}, ");
+	p_output.append(p_godot_method.is_gc_safe ? "\treturn ptrcall_gc_safe(method_bind, " : "\treturn ptrcall(method_bind, ");
 	if (p_godot_type.is_singleton) {
-		p_output.append("getfield(singleton, :native_ptr)::Ptr{Nothing}");
+		p_output.append("getfield(singleton[], :native_ptr)");
 	} else {
-		p_output.append("getfield(self, :native_ptr)::Ptr{Nothing}");
+		p_output.append("getfield(self, :native_ptr)");
+	}
+	p_output.append(vformat(", %s", return_type_name));
+	for (int i = 0; i < argc; i++) {
+		p_output.append(vformat(", %s", p_godot_method.arguments.get(i).name));
 	}
-	p_output.append(vformat(", %s, %s)::Cvoid\n", args_ptrcall_typed, ret_ptrcall_typed));
+	p_output.append(")\n");
+	p_output.append("end\n\n");
 
-	if (return_type != nullptr) {
-		p_output.append("\t\treturn ");
-		p_output.append(vformat(return_type->ptrcall_output, "ret"));
-		p_output.append("\n");
+	// Used by Godot.call_batch to call the method on many objects at once.
+	if (!p_godot_type.is_singleton) {
+		p_output.append(vformat("@inline method_bind_info(::typeof(%s), ::Type{<:Godot%s}) = (@inbounds(method_binds_%s[%d]), %s)\n\n",
+				p_godot_method.julia_name, p_godot_type.julia_name, p_godot_type.julia_name, p_method_bind_index, return_type_name));
 	}
+}
 
-	p_output.append("\tend\nend\n\n");
+const BindingsGenerator::GodotMethod *BindingsGenerator::_find_generated_method(const GodotType &p_godot_type, const StringName &p_name) {
+	const GodotType *godot_type = &p_godot_type;
+	while (true) {
+		for (const GodotMethod &godot_method : godot_type->methods) {
+			if (godot_method.name == p_name) {
+				return &godot_method;
+			}
+		}
+		if (godot_type->parent_class_name == StringName()) {
+			return nullptr;
+		}
+		godot_type = &object_types[godot_type->parent_class_name];
+	}
 }
 
 void BindingsGenerator::_generate_julia_properties(const GodotType &p_godot_type, StringBuilder &p_output) {
 	// TODO: Use composition rather than inheritance?
 
-	// Getters.
-	p_output.append(vformat("function Base.getproperty(object::Godot%s, property::Symbol)\n", p_godot_type.julia_name));
-	bool first = true;
-	const GodotType *ancestor = &p_godot_type;
-	while (ancestor->parent_class_name != StringName()) { // NOTE: Object itself has no properties.
-		for (const GodotProperty &godot_property : ancestor->properties) {
-			p_output.append(vformat("\t%s property == :", first ? "if" : "elseif"));
-			p_output.append(godot_property.julia_name);
-			p_output.append("\n");
-			p_output.append(vformat("\t\treturn %s(object)\n", godot_property.getter));
-			first = false;
-		}
-		ancestor = &object_types[ancestor->parent_class_name];
+	// Properties are dispatched on Val(property), so that accessing a property by a constant name compiles to a
+	// direct call of its getter/setter. Subclasses inherit the methods of the properties of their ancestors.
+	if (p_godot_type.parent_class_name == StringName()) {
+		p_output.append("@inline Base.getproperty(object::GodotObject, property::Symbol) = get_property(object, Val(property))\n");
+		p_output.append("@inline Base.setproperty!(object::GodotObject, property::Symbol, value) = set_property!(object, Val(property), value)\n\n");
+		p_output.append("@inline get_property(object::GodotObject, ::Val{property}) where {property} = getfield(object, property)\n");
+		p_output.append("@inline set_property!(object::GodotObject, ::Val{property}, value) where {property} = setfield!(object, property, value)\n\n");
 	}
-	if (first) {
-		p_output.append("\treturn getfield(object, property)\n");
-	} else {
-		p_output.append("\telse\n");
-		p_output.append("\t\treturn getfield(object, property)\n");
-		p_output.append("\tend\n");
-	}
-	p_output.append("end\n\n");
 
-	// Setters.
-	first = true;
-	ancestor = &p_godot_type;
-	// TODO: Add multiple specialized methods, one for each type of value?
-	p_output.append(vformat("function Base.setproperty!(object::Godot%s, property::Symbol, value)\n", p_godot_type.julia_name));
-	while (ancestor->parent_class_name != StringName()) { // NOTE: Object itself has no properties.
-		for (const GodotProperty &godot_property : ancestor->properties) {
-			if (godot_property.setter == StringName()) { // NOTE: Read-only property.
-				continue;
-			}
-			p_output.append(vformat("\t%s property == :", first ? "if" : "elseif"));
-			p_output.append(godot_property.julia_name);
-			p_output.append("\n");
-			p_output.append(vformat("\t\t%s(object, value)\n", godot_property.setter));
-			first = false;
+	for (const GodotProperty &godot_property : p_godot_type.properties) {
+		// NOTE: An indexed property passes its index as the first argument of its getter/setter.
+		int index_argc = godot_property.index == -1 ? 0 : 1;
+		String index_argument = godot_property.index == -1 ? "" : vformat(", %d", godot_property.index);
+		// The escaped name, e.g. `object._end` for a property named after a keyword.
+		String property_symbol = ":" + godot_property.julia_name;
+
+		const GodotMethod *getter = godot_property.getter == StringName() ? nullptr : _find_generated_method(p_godot_type, godot_property.getter);
+		if (getter && getter->arguments.size() == index_argc) {
+			p_output.append(vformat("get_property(object::Godot%s, ::Val{%s}) = %s(object%s)\n",
+					p_godot_type.julia_name, property_symbol, getter->julia_name, index_argument));
+		}
+
+		const GodotMethod *setter = godot_property.setter == StringName() ? nullptr : _find_generated_method(p_godot_type, godot_property.setter);
+		if (setter && setter->arguments.size() == index_argc + 1) {
+			const GodotType *value_type = _get_type_or_null(setter->arguments.get(index_argc).type);
+			ERR_CONTINUE(!value_type);
+			p_output.append(vformat("set_property!(object::Godot%s, ::Val{%s}, value) = %s(object%s, convert(%s, value))\n",
+					p_godot_type.julia_name, property_symbol, setter->julia_name, index_argument, value_type->julia_name));
 		}
-		ancestor = &object_types[ancestor->parent_class_name];
-	}
-	if (first) {
-		p_output.append("\tsetfield!(object, property, value)\n");
-	} else {
-		p_output.append("\telse\n");
-		p_output.append("\t\tsetfield!(object, property, value)\n");
-		p_output.append("\tend\n");
 	}
-	p_output.append("end\n");
+	p_output.append("\n");
 }
 
 const BindingsGenerator::GodotType *BindingsGenerator::_get_type_or_null(const TypeReference &p_typeref) {
@@ -517,6 +551,18 @@ void BindingsGenerator::_generate_julia_object_types_includes(StringBuilder &p_o
 	for (const StringName &include : includes) {
 		p_output.append(vformat("include(\"classes/%s.jl\");\n", include));
 	}
+
+	// Singletons' method binds live in the module of the singleton.
+	p_output.append("\nfunction init_method_binds()\n");
+	for (const StringName &include : includes) {
+		const GodotType &godot_type = object_types[include];
+		if (godot_type.is_singleton) {
+			p_output.append(vformat("\t%s.init_method_binds_%s()\n", godot_type.julia_name, godot_type.julia_name));
+		} else {
+			p_output.append(vformat("\tinit_method_binds_%s()\n", godot_type.julia_name));
+		}
+	}
+	p_output.append("end\n");
 }
 
 void BindingsGenerator::_populate_object_types() {
@@ -557,10 +603,6 @@ void BindingsGenerator::_populate_object_types() {
 		GodotType godot_class;
 		godot_class.name = class_name;
 		godot_class.julia_name = class_name;
-		godot_class.ptrcall_type = "Ptr{Nothing}";
-		godot_class.ptrcall_initial = "C_NULL";
-		godot_class.ptrcall_input = "getfield(%s, :native_ptr)";
-		godot_class.ptrcall_output = vformat("%s(%%s)", class_name);
 		godot_class.is_object_type = true;
 		godot_class.is_singleton = Engine::get_singleton()->has_singleton(class_name);
 		godot_class.is_instantiable = class_info->creation_func && !godot_class.is_singleton;
@@ -645,7 +687,16 @@ void BindingsGenerator::_populate_object_types() {
 							argument_type == Variant::VECTOR3 ||
 							argument_type == Variant::VECTOR3I ||
 							argument_type == Variant::VECTOR4 ||
-							argument_type == Variant::VECTOR4I)) {
+							argument_type == Variant::VECTOR4I ||
+							argument_type == Variant::PACKED_BYTE_ARRAY ||
+							argument_type == Variant::PACKED_INT32_ARRAY ||
+							argument_type == Variant::PACKED_INT64_ARRAY ||
+							argument_type == Variant::PACKED_FLOAT32_ARRAY ||
+							argument_type == Variant::PACKED_FLOAT64_ARRAY ||
+							argument_type == Variant::PACKED_VECTOR2_ARRAY ||
+							argument_type == Variant::PACKED_VECTOR3_ARRAY ||
+							argument_type == Variant::PACKED_COLOR_ARRAY ||
+							argument_type == Variant::PACKED_VECTOR4_ARRAY)) {
 					arguments_supported = false;
 					break;
 				}
@@ -694,13 +745,23 @@ void BindingsGenerator::_populate_object_types() {
 						return_info.type == Variant::VECTOR3 ||
 						return_info.type == Variant::VECTOR3I ||
 						return_info.type == Variant::VECTOR4 ||
-						return_info.type == Variant::VECTOR4I)) {
+						return_info.type == Variant::VECTOR4I ||
+						return_info.type == Variant::PACKED_BYTE_ARRAY ||
+						return_info.type == Variant::PACKED_INT32_ARRAY ||
+						return_info.type == Variant::PACKED_INT64_ARRAY ||
+						return_info.type == Variant::PACKED_FLOAT32_ARRAY ||
+						return_info.type == Variant::PACKED_FLOAT64_ARRAY ||
+						return_info.type == Variant::PACKED_VECTOR2_ARRAY ||
+						return_info.type == Variant::PACKED_VECTOR3_ARRAY ||
+						return_info.type == Variant::PACKED_COLOR_ARRAY ||
+						return_info.type == Variant::PACKED_VECTOR4_ARRAY)) {
 				continue;
 			}
 
 			MethodBind *method_bind = godot_method.is_virtual ? nullptr : ClassDB::get_method(class_name, method_info.name);
 
 			godot_method.is_vararg = method_bind && method_bind->is_vararg();
+			godot_method.is_gc_safe = _is_gc_safe_method(class_name, godot_method.name);
 
 			// TODO: Handle vararg methods.
 			if (godot_method.is_vararg) {
@@ -809,10 +870,6 @@ void BindingsGenerator::_populate_object_types() {
 			enum_type.is_enum = true;
 			enum_type.name = vformat("%s.%s", class_name, genum.name);
 			enum_type.julia_name = genum.julia_qualified_name;
-			enum_type.ptrcall_type = "Ref{Cint}";
-			enum_type.ptrcall_initial = "Ref{Cint}(0)";
-			enum_type.ptrcall_input = "Ref{Cint}(Cint(%s))";
-			enum_type.ptrcall_output = vformat("%s(%%s[])", genum.julia_qualified_name);
 			enum_types.insert(enum_type.name, enum_type);
 		}
 
@@ -868,187 +925,153 @@ void BindingsGenerator::_populate_builtin_types() {
 	// bool
 	godot_type.name = "bool";
 	godot_type.julia_name = "Bool";
-	godot_type.ptrcall_type = "Ref{Cint}";
-	godot_type.ptrcall_initial = "Ref{Cint}(0)";
-	godot_type.ptrcall_input = "Ref{Cint}(%s)";
-	godot_type.ptrcall_output = "Bool(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
-	// NOTE: The expected type for all integer types in ptrcall is int64_t.
+	// NOTE: ptrcall passes all integer types as int64_t (see Ptrcall.jl).
 
 	// sbyte
 	godot_type.name = "sbyte";
 	godot_type.julia_name = "Int8";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "Int8(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// short
 	godot_type.name = "short";
 	godot_type.julia_name = "Int16";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "Int16(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// int
 	godot_type.name = "int";
 	godot_type.julia_name = "Int32";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "Int32(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// long
 	godot_type.name = "long";
 	godot_type.julia_name = "Int64";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// byte
 	godot_type.name = "byte";
 	godot_type.julia_name = "UInt8";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "UInt8(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// ushort
 	godot_type.name = "ushort";
 	godot_type.julia_name = "UInt16";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "UInt16(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// uint
 	godot_type.name = "uint";
 	godot_type.julia_name = "UInt32";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(%s)";
-	godot_type.ptrcall_output = "UInt32(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// ulong
 	godot_type.name = "ulong";
 	godot_type.julia_name = "UInt64";
-	godot_type.ptrcall_type = "Ref{Int64}";
-	godot_type.ptrcall_initial = "Ref{Int64}(0)";
-	godot_type.ptrcall_input = "Ref{Int64}(reinterpret(Int64, %s))";
-	godot_type.ptrcall_output = "reinterpret(UInt64, %s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
-	// NOTE: The expected type for all floating point types in ptrcall is double.
+	// NOTE: ptrcall passes all floating point types as double (see Ptrcall.jl).
 
 	// float
 	godot_type.name = "float";
 	godot_type.julia_name = "Float32";
-	godot_type.ptrcall_type = "Ref{Float64}";
-	godot_type.ptrcall_initial = "Ref{Float64}(0.0)";
-	godot_type.ptrcall_input = "Ref{Float64}(%s)";
-	godot_type.ptrcall_output = "Float32(%s[])";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// double
 	godot_type.name = "double";
 	godot_type.julia_name = "Float64";
-	godot_type.ptrcall_type = "Ref{Float64}";
-	godot_type.ptrcall_initial = "Ref{Float64}(0.0)";
-	godot_type.ptrcall_input = "Ref{Float64}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// String
 	godot_type.name = "String";
 	godot_type.julia_name = "GodotString";
-	godot_type.ptrcall_type = "Ref{GodotString}";
-	godot_type.ptrcall_initial = "Ref{GodotString}(GodotString(\"\"))";
-	godot_type.ptrcall_input = "Ref{GodotString}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// StringName
 	godot_type.name = "StringName";
 	godot_type.julia_name = "StringName";
-	godot_type.ptrcall_type = "Ref{StringName}";
-	godot_type.ptrcall_initial = "Ref{StringName}(StringName(GodotString(\"\")))";
-	godot_type.ptrcall_input = "Ref{StringName}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector2
 	godot_type.name = "Vector2";
 	godot_type.julia_name = "Vector2";
-	godot_type.ptrcall_type = "Ref{Vector2}";
-	godot_type.ptrcall_initial = "Ref{Vector2}(Vector2(0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector2}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector2i
 	godot_type.name = "Vector2i";
 	godot_type.julia_name = "Vector2i";
-	godot_type.ptrcall_type = "Ref{Vector2i}";
-	godot_type.ptrcall_initial = "Ref{Vector2i}(Vector2i(0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector2i}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector3
 	godot_type.name = "Vector3";
 	godot_type.julia_name = "Vector3";
-	godot_type.ptrcall_type = "Ref{Vector3}";
-	godot_type.ptrcall_initial = "Ref{Vector3}(Vector3(0, 0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector3}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector3i
 	godot_type.name = "Vector3i";
 	godot_type.julia_name = "Vector3i";
-	godot_type.ptrcall_type = "Ref{Vector3i}";
-	godot_type.ptrcall_initial = "Ref{Vector3i}(Vector3i(0, 0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector3i}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector4
 	godot_type.name = "Vector4";
 	godot_type.julia_name = "Vector4";
-	godot_type.ptrcall_type = "Ref{Vector4}";
-	godot_type.ptrcall_initial = "Ref{Vector4}(Vector4(0, 0, 0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector4}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// Vector4i
 	godot_type.name = "Vector4i";
 	godot_type.julia_name = "Vector4i";
-	godot_type.ptrcall_type = "Ref{Vector4i}";
-	godot_type.ptrcall_initial = "Ref{Vector4i}(Vector4i(0, 0, 0, 0))";
-	godot_type.ptrcall_input = "Ref{Vector4i}(%s)";
-	godot_type.ptrcall_output = "%s[]";
 	builtin_types.insert(godot_type.name, godot_type);
 
 	// TODO: More struct types.
 
+
+	// PackedByteArray
+	godot_type.name = "PackedByteArray";
+	godot_type.julia_name = "PackedByteArray";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedInt32Array
+	godot_type.name = "PackedInt32Array";
+	godot_type.julia_name = "PackedInt32Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedInt64Array
+	godot_type.name = "PackedInt64Array";
+	godot_type.julia_name = "PackedInt64Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedFloat32Array
+	godot_type.name = "PackedFloat32Array";
+	godot_type.julia_name = "PackedFloat32Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedFloat64Array
+	godot_type.name = "PackedFloat64Array";
+	godot_type.julia_name = "PackedFloat64Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedVector2Array
+	godot_type.name = "PackedVector2Array";
+	godot_type.julia_name = "PackedVector2Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedVector3Array
+	godot_type.name = "PackedVector3Array";
+	godot_type.julia_name = "PackedVector3Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedColorArray
+	godot_type.name = "PackedColorArray";
+	godot_type.julia_name = "PackedColorArray";
+	builtin_types.insert(godot_type.name, godot_type);
+
+	// PackedVector4Array
+	godot_type.name = "PackedVector4Array";
+	godot_type.julia_name = "PackedVector4Array";
+	builtin_types.insert(godot_type.name, godot_type);
+
 	// Variant
 	godot_type.name = "Variant";
 	godot_type.julia_name = "Variant";
-	godot_type.ptrcall_type = "Ref{Variant}";
-	godot_type.ptrcall_initial = "Variant()";
-	godot_type.ptrcall_input = "Ref{Variant}(%s)";
-	godot_type.ptrcall_output = "%s";
 	builtin_types.insert(godot_type.name, godot_type);
 }
 
@@ -1106,10 +1129,6 @@ void BindingsGenerator::_populate_global_constants() {
 		enum_type.is_enum = true;
 		enum_type.name = godot_enum.name;
 		enum_type.julia_name = godot_enum.julia_qualified_name;
-		enum_type.ptrcall_type = "Ref{Cint}";
-		enum_type.ptrcall_initial = "Ref{Cint}(0)";
-		enum_type.ptrcall_input = "Ref{Cint}(Cint(%s))";
-		enum_type.ptrcall_output = vformat("%s(%%s[])", godot_enum.julia_qualified_name);
 		enum_types.insert(enum_type.name, enum_type);
 		// TODO: Handle prefixes?
 	}
@@ -1203,16 +1222,15 @@ Error BindingsGenerator::generate_julia_sources(const String &p_sources_dir) {
 }
 
 Error BindingsGenerator::install_julia_package(const String &p_package_dir) {
-	// TODO: Don't use Pkg.develop, and build a sysimage instead?
+	ERR_FAIL_COND_V(!JuliaLanguage::get_singleton()->initialize_runtime(), FAILED);
+	JuliaThreadScope thread_scope;
+
+	// NOTE: Exported projects load Godot.jl from a sysimage instead, see JuliaExportPlugin.
 	jl_eval_string("using Pkg");
 	jl_eval_string(("Pkg.develop(path=\"" + p_package_dir + "\")").utf8().get_data());
 
 	if (jl_exception_occurred()) {
-		// None of these allocate, so a gc-root (JL_GC_PUSH) is not necessary.
-		jl_value_t *exception_str = jl_call2(jl_get_function(jl_base_module, "sprint"),
-				jl_get_function(jl_base_module, "showerror"),
-				jl_exception_occurred());
-		ERR_FAIL_V_MSG(FAILED, jl_string_ptr(exception_str));
+		ERR_FAIL_V_MSG(FAILED, julia_exception_string());
 	}
 
 	_log("\nThe Julia package " + String(JULIA_PKG_NAME) + " was successfully installed.\n");
@@ -1221,6 +1239,7 @@ Error BindingsGenerator::install_julia_package(const String &p_package_dir) {
 }
 
 void BindingsGenerator::precompile_julia_package() {
+	JuliaThreadScope thread_scope;
 	jl_eval_string("Pkg.precompile()");
 }
 
@@ -88,6 +88,8 @@ class BindingsGenerator {
 		bool is_static = false;
 		bool is_virtual = false;
 		bool is_vararg = false;
+		// Called in a GC-safe region, because it can block or run for a long time.
+		bool is_gc_safe = false;
 
 		TypeReference return_type;
 
@@ -108,15 +110,6 @@ class BindingsGenerator {
 		bool is_instantiable = false;
 		bool is_ref_counted = false;
 
-		// The reference type for the argument/return value passed into ptrcall.
-		String ptrcall_type;
-		// The initial value for the return value passed into ptrcall.
-		String ptrcall_initial;
-		// The format string to obtain the argument reference value passed into ptrcall.
-		String ptrcall_input;
-		// The format string to obtain the final return value from the ptrcall return value.
-		String ptrcall_output;
-
 		StringName parent_class_name;
 		ClassDB::APIType api_type = ClassDB::API_NONE;
 
@@ -150,11 +143,12 @@ class BindingsGenerator {
 	void _populate_object_type_dependencies();
 
 	const GodotType *_get_type_or_null(const TypeReference &p_typeref);
+	const GodotMethod *_find_generated_method(const GodotType &p_godot_type, const StringName &p_name);
 
 	void _generate_core_constants(StringBuilder &p_output);
 	void _generate_global_constants(StringBuilder &p_output);
 	void _generate_julia_type(const GodotType &p_godot_type, StringBuilder &p_output);
-	void _generate_julia_method(const GodotType &p_godot_type, const GodotMethod &p_godot_method, StringBuilder &p_output);
+	void _generate_julia_method(const GodotType &p_godot_type, const GodotMethod &p_godot_method, int p_method_bind_index, StringBuilder &p_output);
 	void _generate_julia_properties(const GodotType &p_godot_type, StringBuilder &p_output);
 	void _generate_julia_object_types_includes(StringBuilder &p_output);
 
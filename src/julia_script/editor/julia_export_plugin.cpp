@@ -0,0 +1,96 @@
+#include "julia_export_plugin.h"
+
+#ifdef TOOLS_ENABLED
+
+#include "../julia_language.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+#include <julia.h>
+
+void JuliaExportPlugin::_find_scripts(const String &p_dir, Vector<String> &r_scripts) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	ERR_FAIL_COND(dir.is_null());
+
+	dir->list_dir_begin();
+	for (String name = dir->get_next(); !name.is_empty(); name = dir->get_next()) {
+		// Skips hidden files and directories, such as .godot.
+		if (name.begins_with(".")) {
+			continue;
+		}
+		String path = p_dir.path_join(name);
+		if (dir->current_is_dir()) {
+			_find_scripts(path, r_scripts);
+		} else if (name.get_extension() == "jl") {
+			r_scripts.push_back(path);
+		}
+	}
+	dir->list_dir_end();
+}
+
+void JuliaExportPlugin::_export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+	if (!bool(GLOBAL_GET("julia/export/build_sysimage"))) {
+		return;
+	}
+
+	// PackageCompiler builds the sysimage for the platform which it runs on.
+	String host_platform = OS::get_singleton()->get_name().to_lower();
+	String extension;
+	if (p_features.has("linux") && host_platform == "linux") {
+		extension = "so";
+	} else if (p_features.has("windows") && host_platform == "windows") {
+		extension = "dll";
+	} else if (p_features.has("macos") && host_platform == "macos") {
+		extension = "dylib";
+	}
+	ERR_FAIL_COND_MSG(extension.is_empty(), "The Julia sysimage can only be built when exporting for the platform of the editor (" + host_platform + ").");
+
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	ERR_FAIL_COND_MSG(!language->load_godot_module(), "Cannot build the Julia sysimage without the Julia package Godot.jl");
+
+	String precompile_statements_path = GLOBAL_GET("julia/export/precompile_statements_path");
+	Vector<String> scripts;
+	_find_scripts("res://", scripts);
+	// The recorded precompile statements are not a script.
+	scripts.erase(precompile_statements_path);
+	if (!FileAccess::exists(precompile_statements_path)) {
+		precompile_statements_path = "";
+	}
+
+	String sysimage_dir = ProjectSettings::get_singleton()->get_project_data_path().path_join("julia");
+	String sysimage_path = ProjectSettings::get_singleton()->globalize_path(sysimage_dir.path_join(String(JULIA_SYSIMAGE_BASENAME) + "." + extension));
+	ERR_FAIL_COND(DirAccess::make_dir_recursive_absolute(ProjectSettings::get_singleton()->globalize_path(sysimage_dir)) != OK);
+
+	print_line(vformat("Building the Julia sysimage with %d scripts, which can take several minutes...", scripts.size()));
+
+	JuliaThreadScope thread_scope;
+
+	jl_array_t *julia_paths = nullptr;
+	jl_array_t *julia_res_paths = nullptr;
+	jl_value_t *julia_sysimage_path = nullptr;
+	jl_value_t *julia_precompile_statements_path = nullptr;
+	JL_GC_PUSH4(&julia_paths, &julia_res_paths, &julia_sysimage_path, &julia_precompile_statements_path);
+	julia_paths = jl_alloc_vec_any(scripts.size());
+	julia_res_paths = jl_alloc_vec_any(scripts.size());
+	for (int i = 0; i < scripts.size(); i++) {
+		jl_array_ptr_set(julia_paths, i, jl_cstr_to_string(ProjectSettings::get_singleton()->globalize_path(scripts[i]).utf8().get_data()));
+		jl_array_ptr_set(julia_res_paths, i, jl_cstr_to_string(scripts[i].utf8().get_data()));
+	}
+	julia_sysimage_path = jl_cstr_to_string(sysimage_path.utf8().get_data());
+	julia_precompile_statements_path = jl_cstr_to_string(ProjectSettings::get_singleton()->globalize_path(precompile_statements_path).utf8().get_data());
+
+	jl_value_t *args[4] = { julia_sysimage_path, (jl_value_t *)julia_paths, (jl_value_t *)julia_res_paths, julia_precompile_statements_path };
+	jl_call(language->runtime_functions.build_sysimage, args, 4);
+	JL_GC_POP();
+	if (jl_exception_occurred()) {
+		ERR_FAIL_MSG(String("Failed to build the Julia sysimage: ") + julia_exception_string());
+	}
+
+	// Shipped next to the executable, where the runtime looks for it.
+	add_shared_object(sysimage_path, Vector<String>(), "");
+}
+
+#endif // TOOLS_ENABLED
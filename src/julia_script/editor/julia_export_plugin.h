@@ -0,0 +1,24 @@
+#ifndef JULIA_EXPORT_PLUGIN_H
+#define JULIA_EXPORT_PLUGIN_H
+
+#ifdef TOOLS_ENABLED
+
+#include "editor/export/editor_export_plugin.h"
+
+// Builds a sysimage containing Godot.jl and the project's Julia scripts when exporting, and ships it next to the
+// executable, so that exported projects don't have to load and compile them at startup.
+class JuliaExportPlugin : public EditorExportPlugin {
+	GDCLASS(JuliaExportPlugin, EditorExportPlugin);
+
+	static void _find_scripts(const String &p_dir, Vector<String> &r_scripts);
+
+protected:
+	void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override;
+
+public:
+	String get_name() const override { return "JuliaScript"; }
+};
+
+#endif // TOOLS_ENABLED
+
+#endif // JULIA_EXPORT_PLUGIN_H
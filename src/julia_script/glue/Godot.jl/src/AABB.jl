@@ -0,0 +1,17 @@
+"""
+A 3D axis-aligned bounding box.
+"""
+struct AABB
+    position::Vector3
+    size::Vector3
+end
+
+# Display.
+
+function Base.show(io::Core.IO, b::AABB)
+    print(io, "AABB(", b.position, ", ", b.size, ")")
+end
+
+# Constructors.
+
+AABB() = AABB(Vector3(), Vector3())
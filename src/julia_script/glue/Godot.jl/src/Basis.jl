@@ -0,0 +1,20 @@
+include("generated/core_constants.jl")
+
+"""
+A 3×3 matrix for representing 3D rotation and scale.
+
+NOTE: The matrix is stored by rows, like in the engine.
+"""
+struct Basis
+    rows::NTuple{3, Vector3}
+end
+
+# Display.
+
+function Base.show(io::Core.IO, b::Basis)
+    print(io, "Basis(", b.rows[1], ", ", b.rows[2], ", ", b.rows[3], ")")
+end
+
+# Constructors.
+
+Basis() = Basis((Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)))
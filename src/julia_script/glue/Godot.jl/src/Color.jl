@@ -0,0 +1,21 @@
+"""
+A color represented in RGBA format by a red (r), green (g), blue (b), and alpha (a) component.
+"""
+struct Color
+    r::Float32
+    g::Float32
+    b::Float32
+    a::Float32
+end
+
+# Display.
+
+function Base.show(io::Core.IO, c::Color)
+    print(io, "Color(", c.r, ", ", c.g, ", ", c.b, ", ", c.a, ")")
+end
+
+# Constructors.
+
+Color() = Color(0, 0, 0, 1)
+
+Color(r::Real, g::Real, b::Real) = Color(r, g, b, 1)
@@ -9,7 +9,28 @@ include("Vector3.jl")
 include("Vector3i.jl")
 include("Vector4.jl")
 include("Vector4i.jl")
+include("Color.jl")
+include("Rect2.jl")
+include("Rect2i.jl")
+include("Transform2D.jl")
+include("Basis.jl")
+include("Transform3D.jl")
+include("Quaternion.jl")
+include("AABB.jl")
+include("Plane.jl")
+include("Projection.jl")
+include("RID.jl")
 include("Variant.jl")
+include("PackedArray.jl")
+include("Ptrcall.jl")
+include("Parallel.jl")
 include("generated/classes.jl")
+include("Runtime.jl")
+
+function __init__()
+	# The engine's method binds are not available while the package is being precompiled.
+	ccall(:jl_generating_output, Cint, ()) == 1 && return
+	init_method_binds()
+end
 
 end # module
@@ -0,0 +1,88 @@
+"""
+A view of the elements of a packed array of the engine, such as a `PackedByteArray`, which doesn't copy them.
+
+Like the engine's packed arrays, the view is copy-on-write: writing to it copies the elements first only if they are
+shared with another packed array, e.g. after the view was passed to the engine.
+"""
+mutable struct PackedArray{T, V} <: AbstractVector{T}
+	variant::Variant
+	data::Ptr{T}
+	length::Int
+	writable::Bool
+	function PackedArray{T, V}(variant::Variant) where {T, V}
+		return refresh!(new{T, V}(variant, C_NULL, 0, false))
+	end
+end
+
+function PackedArray{T, V}() where {T, V}
+	variant = Variant()
+	@ccall godot_julia_packed_array_initialize(variant::Ref{Variant}, Int64(V)::Int64)::Cvoid
+	return PackedArray{T, V}(variant)
+end
+
+function PackedArray{T, V}(values::AbstractVector) where {T, V}
+	array = PackedArray{T, V}()
+	resize!(array, length(values))
+	return copyto!(array, values)
+end
+
+const PackedByteArray = PackedArray{UInt8, TYPE_PACKED_BYTE_ARRAY}
+const PackedInt32Array = PackedArray{Int32, TYPE_PACKED_INT32_ARRAY}
+const PackedInt64Array = PackedArray{Int64, TYPE_PACKED_INT64_ARRAY}
+const PackedFloat32Array = PackedArray{Float32, TYPE_PACKED_FLOAT32_ARRAY}
+const PackedFloat64Array = PackedArray{Float64, TYPE_PACKED_FLOAT64_ARRAY}
+const PackedVector2Array = PackedArray{Vector2, TYPE_PACKED_VECTOR2_ARRAY}
+const PackedVector3Array = PackedArray{Vector3, TYPE_PACKED_VECTOR3_ARRAY}
+const PackedColorArray = PackedArray{Color, TYPE_PACKED_COLOR_ARRAY}
+const PackedVector4Array = PackedArray{Vector4, TYPE_PACKED_VECTOR4_ARRAY}
+
+# Update the view after the engine may have replaced the elements, e.g. when the array was a return value of a method.
+function refresh!(array::PackedArray{T}) where T
+	array_length = Ref{Int64}(0)
+	array.data = @ccall godot_julia_packed_array_ptr(array.variant::Ref{Variant}, array_length::Ref{Int64})::Ptr{T}
+	array.length = array_length[]
+	array.writable = false
+	return array
+end
+
+function make_writable!(array::PackedArray{T}) where T
+	array.data = @ccall godot_julia_packed_array_ptrw(array.variant::Ref{Variant})::Ptr{T}
+	array.writable = true
+	return array
+end
+
+# AbstractVector interface.
+
+Base.size(array::PackedArray) = (array.length,)
+
+Base.IndexStyle(::Type{<:PackedArray}) = IndexLinear()
+
+@inline function Base.getindex(array::PackedArray, i::Int)
+	@boundscheck checkbounds(array, i)
+	return GC.@preserve array unsafe_load(array.data, i)
+end
+
+@inline function Base.setindex!(array::PackedArray{T}, value, i::Int) where T
+	@boundscheck checkbounds(array, i)
+	array.writable || make_writable!(array)
+	GC.@preserve array unsafe_store!(array.data, convert(T, value), i)
+	return array
+end
+
+function Base.resize!(array::PackedArray, n::Integer)
+	@ccall godot_julia_packed_array_resize(array.variant::Ref{Variant}, n::Int64)::Cvoid
+	return refresh!(array)
+end
+
+Base.similar(array::PackedArray{T, V}) where {T, V} = resize!(PackedArray{T, V}(), length(array))
+
+# Passing the view to the engine shares its elements, so the next write has to check whether to copy them.
+function Base.cconvert(::Type{Ptr{Nothing}}, array::PackedArray)
+	array.writable = false
+	return array
+end
+
+# The engine's Vector<T>, as expected by ptrcall.
+function Base.unsafe_convert(::Type{Ptr{Nothing}}, array::PackedArray)
+	return @ccall godot_julia_packed_array_vector(array.variant::Ref{Variant})::Ptr{Nothing}
+end
@@ -0,0 +1,90 @@
+"""
+The state of a `parallel_for` which is shared by the worker threads running its chunks.
+"""
+mutable struct ParallelFor{F}
+	f::F
+	count::Int
+	chunk_size::Int
+	exception_lock::Threads.SpinLock
+	exception::Any
+end
+
+# Called by a worker thread of the engine's WorkerThreadPool, with the index of a chunk.
+function run_parallel_for_chunk(task::ParallelFor, chunk::UInt32)
+	first = Int(chunk) * task.chunk_size + 1
+	last = min(first + task.chunk_size - 1, task.count)
+	try
+		for i in first:last
+			task.f(i)
+		end
+	catch exception
+		# NOTE: Exceptions must not propagate into the engine; the first one is rethrown by the caller.
+		lock(task.exception_lock) do
+			if task.exception === nothing
+				task.exception = CapturedException(exception, catch_backtrace())
+			end
+		end
+	end
+	return nothing
+end
+
+"""
+	worker_thread_count()
+
+Return the number of worker threads of the engine's `WorkerThreadPool`.
+"""
+worker_thread_count() = Int(@ccall godot_julia_worker_thread_pool_get_thread_count()::Int64)
+
+# Enough chunks to balance the load between the worker threads, without the overhead of one task per element.
+default_chunk_size(count::Integer) = max(1, cld(count, 4 * max(worker_thread_count(), 1)))
+
+"""
+	parallel_for(f, n::Integer; chunk_size, high_priority = false)
+	parallel_for(f, collection::AbstractArray; chunk_size, high_priority = false)
+
+Call `f(i)` for every `i` in `1:n`, or `f(x)` for every element `x` of `collection`, on the worker threads of the
+engine's `WorkerThreadPool`, and wait until all calls have returned. The calls are grouped into tasks of `chunk_size`
+consecutive elements, which run in no particular order.
+
+If calls throw, the remaining calls still run, and the first exception is rethrown (as a `CapturedException`).
+
+`f` may call engine methods, as long as they are safe to call from threads other than the main thread.
+"""
+function parallel_for(f::F, count::Integer; chunk_size::Integer = default_chunk_size(count), high_priority::Bool = false) where {F}
+	chunk_size > 0 || throw(ArgumentError("chunk_size must be positive"))
+	count > 0 || return nothing
+	task = ParallelFor{F}(f, count, chunk_size, Threads.SpinLock(), nothing)
+	chunks = cld(count, chunk_size)
+	callback = @cfunction(run_parallel_for_chunk, Cvoid, (Ref{ParallelFor{F}}, UInt32))
+	GC.@preserve task begin
+		@ccall godot_julia_worker_thread_pool_run_group_task(callback::Ptr{Nothing}, pointer_from_objref(task)::Ptr{Nothing}, chunks::Int64, high_priority::Bool)::Cvoid
+	end
+	task.exception === nothing || throw(task.exception)
+	return nothing
+end
+
+function parallel_for(f::F, collection::AbstractArray; kwargs...) where {F}
+	first_index = firstindex(collection)
+	return parallel_for(i -> f(@inbounds collection[first_index+i-1]), length(collection); kwargs...)
+end
+
+"""
+	parallel_map(f, n::Integer; chunk_size, high_priority = false)
+	parallel_map(f, collection::AbstractArray; chunk_size, high_priority = false)
+
+Like `map(f, 1:n)` or `map(f, collection)`, but computes the elements with `parallel_for`. Returns a `Vector`, or an
+`Array` of the shape of `collection`.
+"""
+function parallel_map(f::F, count::Integer; kwargs...) where {F}
+	return parallel_map(f, Base.OneTo(count); kwargs...)
+end
+
+function parallel_map(f::F, collection::AbstractArray; kwargs...) where {F}
+	T = Base.promote_op(f, eltype(collection))
+	result = Array{isconcretetype(T) ? T : Any}(undef, size(collection))
+	first_index = firstindex(collection)
+	parallel_for(length(collection); kwargs...) do i
+		@inbounds result[i] = f(collection[first_index+i-1])
+	end
+	return result
+end
@@ -0,0 +1,19 @@
+include("generated/core_constants.jl")
+
+"""
+A plane in Hessian normal form.
+"""
+struct Plane
+    normal::Vector3
+    d::RealT
+end
+
+# Display.
+
+function Base.show(io::Core.IO, p::Plane)
+    print(io, "Plane(", p.normal, ", ", p.d, ")")
+end
+
+# Constructors.
+
+Plane() = Plane(Vector3(), 0)
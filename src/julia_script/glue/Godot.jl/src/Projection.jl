@@ -0,0 +1,18 @@
+"""
+A 4×4 matrix for 3D projective transformations.
+
+NOTE: The matrix is stored by columns, like in the engine.
+"""
+struct Projection
+    columns::NTuple{4, Vector4}
+end
+
+# Display.
+
+function Base.show(io::Core.IO, p::Projection)
+    print(io, "Projection(", p.columns[1], ", ", p.columns[2], ", ", p.columns[3], ", ", p.columns[4], ")")
+end
+
+# Constructors.
+
+Projection() = Projection((Vector4(1, 0, 0, 0), Vector4(0, 1, 0, 0), Vector4(0, 0, 1, 0), Vector4(0, 0, 0, 1)))
@@ -0,0 +1,260 @@
+const PTRCALL_STACK_SIZE = 64 * 1024
+
+"""
+Per-thread memory for the arguments and return values of `ptrcall`, so that calling an engine method doesn't allocate.
+Nested calls (engine methods calling back into Julia) use the memory above the caller's frame.
+"""
+mutable struct PtrcallStack
+	memory::Vector{UInt8}
+	top::Int
+	PtrcallStack() = new(Vector{UInt8}(undef, PTRCALL_STACK_SIZE), 0)
+end
+
+mutable struct PtrcallStacks
+	@atomic stacks::Vector{PtrcallStack}
+end
+
+# Indexed by thread id. The vector is replaced (never resized) when a thread with a new id appears, so reading it doesn't need a lock.
+const ptrcall_stacks = PtrcallStacks(PtrcallStack[])
+const ptrcall_stacks_lock = ReentrantLock()
+
+@inline function ptrcall_stack()
+	id = Threads.threadid()
+	stacks = @atomic :acquire ptrcall_stacks.stacks
+	id <= length(stacks) && return @inbounds stacks[id]
+	return add_ptrcall_stacks(id)
+end
+
+@noinline function add_ptrcall_stacks(id::Int)
+	lock(ptrcall_stacks_lock) do
+		stacks = @atomic :acquire ptrcall_stacks.stacks
+		if id > length(stacks)
+			new_stacks = copy(stacks)
+			for _ in length(stacks)+1:max(id, Threads.maxthreadid())
+				push!(new_stacks, PtrcallStack())
+			end
+			@atomic :release ptrcall_stacks.stacks = new_stacks
+			stacks = new_stacks
+		end
+		return stacks[id]
+	end
+end
+
+# Each value occupies a 16-byte aligned slot.
+ptrcall_slot_size(size::Integer) = (max(size, 1) + 15) & ~15
+
+# The type in which the engine expects a value of type T, or `nothing` if it's passed by reference.
+function ptrcall_encoding(T::Type)
+	if T === Bool
+		return Bool
+	elseif T <: Integer || T <: Enum
+		# NOTE: The engine passes all integer types (and enums) as int64_t.
+		return Int64
+	elseif T <: AbstractFloat
+		# NOTE: The engine passes all floating point types as double.
+		return Float64
+	elseif isbitstype(T)
+		# Math types, and objects (which are a pointer to the engine's object).
+		return T
+	else
+		return nothing
+	end
+end
+
+function ptrcall_encode_expression(T::Type, value)
+	if T === Bool
+		return value
+	elseif T <: Integer
+		return :($value % Int64)
+	elseif T <: Enum
+		return :(Integer($value) % Int64)
+	elseif T <: AbstractFloat
+		return :(Float64($value))
+	else
+		return value
+	end
+end
+
+function ptrcall_decode_expression(T::Type, value)
+	if T === Bool
+		return value
+	elseif T <: Integer
+		return :($value % $T)
+	elseif T <: Enum || T <: AbstractFloat
+		return :($T($value))
+	else
+		return value
+	end
+end
+
+# The pointer to a value which is passed by reference, i.e. the engine's String, StringName, Variant or Vector<T>.
+ptrcall_reference(value::Union{GodotString, StringName, Variant}) = pointer_from_objref(value)
+ptrcall_reference(array::PackedArray) = Base.unsafe_convert(Ptr{Nothing}, Base.cconvert(Ptr{Nothing}, array))
+
+ptrcall_result(value) = value
+ptrcall_result(array::PackedArray) = refresh!(array)
+
+# Expressions which store the arguments `args` of the given types for ptrcall: their pointers from `pointers`, and the
+# values of those which are passed by value in slots from `values + offset`. Also returns the offset after the slots.
+function ptrcall_argument_stores(argument_types, pointers, values, offset::Int)
+	stores = Expr[]
+	for (i, T) in enumerate(argument_types)
+		S = ptrcall_encoding(T)
+		pointer_slot = :(Ptr{Ptr{Nothing}}($pointers + $(sizeof(Ptr{Nothing}) * (i - 1))))
+		if S === nothing
+			push!(stores, :(unsafe_store!($pointer_slot, ptrcall_reference(args[$i]))))
+		else
+			push!(stores, :(unsafe_store!(Ptr{$S}($values + $offset), $(ptrcall_encode_expression(T, :(args[$i]))))))
+			push!(stores, :(unsafe_store!($pointer_slot, $values + $offset)))
+			offset += ptrcall_slot_size(sizeof(S))
+		end
+	end
+	return stores, offset
+end
+
+# The body of ptrcall, which calls the method bind through the given glue function.
+function ptrcall_expression(R::Type, args, glue_function::Symbol)
+	# The frame holds the argument pointers, followed by the arguments and the return value which are passed by value.
+	stores, frame_size = ptrcall_argument_stores(args, :base, :base, ptrcall_slot_size(sizeof(Ptr{Nothing}) * length(args)))
+	arguments = isempty(args) ? :(C_NULL) : :base
+
+	S = R === Nothing ? nothing : ptrcall_encoding(R)
+	if R === Nothing
+		result = :(C_NULL)
+		initial = :(nothing)
+		load = :(nothing)
+		decode = :(nothing)
+	elseif S === nothing
+		result = :(ptrcall_reference(ret))
+		initial = :($R())
+		load = :(nothing)
+		decode = :(ptrcall_result(ret))
+	else
+		# The engine assigns to the return value (e.g. a Ref<T>), so it starts out zeroed.
+		for offset in 0:sizeof(UInt64):ptrcall_slot_size(sizeof(S))-1
+			push!(stores, :(unsafe_store!(Ptr{UInt64}(base + $(frame_size + offset)), 0)))
+		end
+		result = :(base + $frame_size)
+		initial = :(nothing)
+		load = :(unsafe_load(Ptr{$S}(base + $frame_size)))
+		decode = ptrcall_decode_expression(R, :raw)
+		frame_size += ptrcall_slot_size(sizeof(S))
+	end
+
+	return quote
+		ret = $initial
+		stack = ptrcall_stack()
+		memory = stack.memory
+		top = stack.top
+		if top + $frame_size > length(memory)
+			# Too deeply nested, so the frame gets memory of its own.
+			memory = Vector{UInt8}(undef, $frame_size)
+			frame = 0
+		else
+			frame = top
+			stack.top = top + $frame_size
+		end
+		# The frame is released even if converting an argument throws, and before the return value is decoded, which
+		# may throw too (e.g. for an enum value which Julia doesn't know).
+		raw = GC.@preserve memory args ret begin
+			try
+				base = pointer(memory) + frame
+				$(stores...)
+				ccall($(QuoteNode(glue_function)), Cvoid, (Ptr{Nothing}, Ptr{Nothing}, Ptr{Nothing}, Ptr{Nothing}), method_bind, instance, $arguments, $result)
+				$load
+			finally
+				stack.top = top
+			end
+		end
+		return $decode
+	end
+end
+
+"""
+Call the engine method `method_bind` on the object `instance` with the given arguments, returning a value of type `R`.
+
+The arguments and the return value are converted to and from the engine's representation in per-thread memory, so
+that the call doesn't allocate unless the return value is a mutable type (such as a `GodotString`).
+"""
+@generated function ptrcall(method_bind::Ptr{Nothing}, instance::Ptr{Nothing}, ::Type{R}, args...) where R
+	return ptrcall_expression(R, args, :godot_julia_method_bind_ptrcall)
+end
+
+"""
+Like `ptrcall`, but the engine method runs in a GC-safe region, so that other Julia threads can collect garbage without
+waiting for it to return. Used for methods which can block or run for a long time (e.g. `move_and_slide`), since the
+transitions in and out of the region make short calls slower.
+
+The engine method may still call back into Julia, which leaves the region until the callback returns.
+"""
+@generated function ptrcall_gc_safe(method_bind::Ptr{Nothing}, instance::Ptr{Nothing}, ::Type{R}, args...) where R
+	return ptrcall_expression(R, args, :godot_julia_method_bind_ptrcall_gc_safe)
+end
+
+# Batched calls.
+
+"""
+Return the method bind of the generated method `f` for objects of type `T`, and the Julia type of its return value.
+"""
+function method_bind_info end
+
+@generated function ptrcall_store_arguments!(pointers::Ptr{Ptr{Nothing}}, values::Ptr{UInt8}, args::Tuple)
+	stores, _ = ptrcall_argument_stores(args.parameters, :pointers, :values, 0)
+	return quote
+		$(stores...)
+		return nothing
+	end
+end
+
+@generated function ptrcall_arguments_size(::Type{A}) where A <: Tuple
+	_, size = ptrcall_argument_stores(A.parameters, :pointers, :values, 0)
+	return size
+end
+
+@generated ptrcall_decode(::Type{R}, value) where R = ptrcall_decode_expression(R, :value)
+
+ptrcall_argument_tuple(args::Tuple) = args
+ptrcall_argument_tuple(arg) = (arg,)
+
+"""
+	call_batch(f, objects, arguments = fill((), length(objects)))
+
+Call the generated engine method `f` (e.g. `set_global_position`) on every object in `objects`, passing the tuple
+`arguments[i]` (or the single argument `arguments[i]`) to the call on `objects[i]`, with one call into the engine.
+Default arguments of `f` are not filled in. Returns the vector of return values, or `nothing` if `f` returns nothing.
+
+The return values must be passed by value (i.e. not strings, variants or packed arrays).
+"""
+function call_batch(f::F, objects::AbstractVector{T}, arguments::AbstractVector = fill((), length(objects))) where {F, T <: GodotObject}
+	method_bind, R = method_bind_info(f, T)
+	return ptrcall_batch(method_bind, objects, R, arguments)
+end
+
+function ptrcall_batch(method_bind::Ptr{Nothing}, objects::AbstractVector{<:GodotObject}, ::Type{R}, arguments::AbstractVector) where R
+	count = length(objects)
+	length(arguments) == count || throw(DimensionMismatch("there are $(length(arguments)) argument tuples for $count objects"))
+	A = eltype(arguments) <: Tuple ? eltype(arguments) : Tuple{eltype(arguments)}
+	isconcretetype(A) || throw(ArgumentError("the arguments must have a concrete type, not $A"))
+	S = R === Nothing ? Nothing : ptrcall_encoding(R)
+	S === nothing && throw(ArgumentError("the return type $R is not passed by value"))
+
+	instances = Ptr{Nothing}[getfield(object, :native_ptr) for object in objects]
+	argc = fieldcount(A)
+	stride = ptrcall_arguments_size(A)
+	pointers = Vector{Ptr{Nothing}}(undef, count * argc)
+	values = Vector{UInt8}(undef, count * stride)
+	# The engine assigns to the return values (e.g. a Ref<T>), so they start out zeroed.
+	results = Vector{S}(undef, R === Nothing ? 0 : count)
+	GC.@preserve results ccall(:memset, Ptr{Nothing}, (Ptr{Nothing}, Cint, Csize_t), results, 0, sizeof(results))
+
+	GC.@preserve arguments instances pointers values results begin
+		for (i, args) in enumerate(arguments)
+			ptrcall_store_arguments!(pointer(pointers, (i - 1) * argc + 1), pointer(values, (i - 1) * stride + 1), ptrcall_argument_tuple(args)::A)
+		end
+		@ccall godot_julia_method_bind_ptrcall_batch(method_bind::Ptr{Nothing}, instances::Ptr{Ptr{Nothing}}, count::Int64, pointers::Ptr{Ptr{Nothing}}, argc::Int64, (R === Nothing ? C_NULL : pointer(results))::Ptr{Nothing}, sizeof(S)::Int64)::Cvoid
+	end
+
+	R === Nothing && return nothing
+	S === R && return results
+	return R[ptrcall_decode(R, result) for result in results]
+end
@@ -0,0 +1,21 @@
+include("generated/core_constants.jl")
+
+"""
+A unit quaternion used for representing 3D rotations.
+"""
+struct Quaternion
+    x::RealT
+    y::RealT
+    z::RealT
+    w::RealT
+end
+
+# Display.
+
+function Base.show(io::Core.IO, q::Quaternion)
+    print(io, "Quaternion(", q.x, ", ", q.y, ", ", q.z, ", ", q.w, ")")
+end
+
+# Constructors.
+
+Quaternion() = Quaternion(0, 0, 0, 1)
@@ -0,0 +1,16 @@
+"""
+A handle for a resource's unique identifier.
+"""
+struct RID
+    id::UInt64
+end
+
+# Display.
+
+function Base.show(io::Core.IO, rid::RID)
+    print(io, "RID(", rid.id, ")")
+end
+
+# Constructors.
+
+RID() = RID(0)
@@ -0,0 +1,21 @@
+include("generated/core_constants.jl")
+
+"""
+A 2D axis-aligned bounding box using floating point coordinates.
+"""
+struct Rect2
+    position::Vector2
+    size::Vector2
+end
+
+# Display.
+
+function Base.show(io::Core.IO, r::Rect2)
+    print(io, "Rect2(", r.position, ", ", r.size, ")")
+end
+
+# Constructors.
+
+Rect2() = Rect2(Vector2(), Vector2())
+
+Rect2(x::Real, y::Real, width::Real, height::Real) = Rect2(Vector2(x, y), Vector2(width, height))
@@ -0,0 +1,19 @@
+"""
+A 2D axis-aligned bounding box using integer coordinates.
+"""
+struct Rect2i
+    position::Vector2i
+    size::Vector2i
+end
+
+# Display.
+
+function Base.show(io::Core.IO, r::Rect2i)
+    print(io, "Rect2i(", r.position, ", ", r.size, ")")
+end
+
+# Constructors.
+
+Rect2i() = Rect2i(Vector2i(), Vector2i())
+
+Rect2i(x::Integer, y::Integer, width::Integer, height::Integer) = Rect2i(Vector2i(x, y), Vector2i(width, height))
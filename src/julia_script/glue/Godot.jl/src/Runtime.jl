@@ -0,0 +1,260 @@
+"""
+Helper functions called by the Julia script language implementation in the engine.
+"""
+module Runtime
+
+import Profile
+
+"""
+Return the functions of the Julia script module `m` that can be called from the engine,
+as a vector of `(name, function, argument_names, line)` tuples. The argument names exclude `self`.
+"""
+function script_functions(m::Module)
+	functions = Any[]
+	for name in names(m; all = true)
+		if name in (:new, :eval, :include) || startswith(String(name), '#')
+			continue
+		end
+		isdefined(m, name) || continue
+		f = getfield(m, name)
+		if !(f isa Function) || parentmodule(f) !== m
+			continue
+		end
+		function_methods = methods(f)
+		isempty(function_methods) && continue
+		# The first two argument names are the function itself and `self`.
+		method = first(function_methods)
+		argument_names = Base.method_argnames(method)
+		push!(functions, (name, f, argument_names[3:end], Int64(method.line)))
+	end
+	return functions
+end
+
+"""
+Construct the Julia instances of a script for the given owner objects, by calling the script module's `new`
+function on a `base_type` struct wrapping each owner.
+
+Returns a vector of instances and a vector of exceptions, with `nothing` in the places where there was no instance
+or no exception, respectively.
+"""
+function new_instances(new::F, base_type::Type{T}, owners::Vector{Ptr{Nothing}}) where {F, T}
+	instances = Vector{Any}(nothing, length(owners))
+	exceptions = Vector{Any}(nothing, length(owners))
+	for (i, owner) in enumerate(owners)
+		try
+			instances[i] = new(base_type(owner))
+		catch exception
+			exceptions[i] = exception
+		end
+	end
+	return instances, exceptions
+end
+
+# NOTE: These must be kept in sync with JuliaScript::CallbackSignature.
+const CALLBACK_SIGNATURE_SELF = 1
+const CALLBACK_SIGNATURE_SELF_FLOAT = 2
+const CALLBACK_SIGNATURE_SELF_OBJECT = 3
+
+# The types of the arguments after `self` which the engine passes to a callback with the given signature.
+function callback_argument_types(signature::Integer)
+	if signature == CALLBACK_SIGNATURE_SELF
+		return ()
+	elseif signature == CALLBACK_SIGNATURE_SELF_FLOAT
+		return (Float64,)
+	elseif signature == CALLBACK_SIGNATURE_SELF_OBJECT
+		return (Any,)
+	else
+		return nothing
+	end
+end
+
+"""
+Compile a C-callable entry point for the engine callback `name` of the script module `m`, specialized for
+the given callback signature. The entry point returns `nothing` on success and the exception otherwise.
+
+Returns `C_NULL` if the callback doesn't have a unique method that can be called with the signature,
+in which case the engine falls back to the generic calling convention.
+"""
+function callback_cfunction(m::Module, name::Symbol, signature::Integer)
+	argument_types = callback_argument_types(signature)
+	argument_types === nothing && return C_NULL
+
+	function_methods = methods(getfield(m, name))
+	length(function_methods) == 1 || return C_NULL
+	method_signature = first(function_methods).sig
+	method_signature isa DataType || return C_NULL
+	parameters = method_signature.parameters
+	length(parameters) == 2 + length(argument_types) || return C_NULL
+	for (argument_type, parameter) in zip(argument_types, parameters[3:end])
+		argument_type <: parameter || argument_type === Any || return C_NULL
+	end
+
+	# Assert the type of self when it's concrete, so that the call inside the entry point is statically dispatched.
+	self_type = parameters[2]
+	self = isconcretetype(self_type) ? :(self::$self_type) : :self
+	arguments = [Symbol("argument_", i) for i in eachindex(argument_types)]
+	entry_point_name = Symbol("#godot_callback#", name)
+	Core.eval(m, quote
+		function $entry_point_name(self, $(arguments...))
+			try
+				$name($self, $(arguments...))
+			catch exception
+				return exception
+			end
+			return nothing
+		end
+	end)
+	return Core.eval(m, :(@cfunction($entry_point_name, Any, (Any, $(argument_types...)))))
+end
+
+"""
+Compile the engine callback `name` of the script module `m` ahead of its first call, for the argument types which the
+engine passes with the given callback signature, and for the type of the instances which the module's `new` function
+returns when called on a `base_type` struct. Also compiles the callback's entry point, if it has one.
+
+Returns whether everything could be compiled.
+"""
+function warm_up_callback(m::Module, name::Symbol, signature::Integer, base_type::Type)
+	argument_types = callback_argument_types(signature)
+	argument_types === nothing && return false
+	self_types = Base.return_types(getfield(m, :new), (base_type,))
+	self_type = length(self_types) == 1 && isconcretetype(self_types[1]) ? self_types[1] : Any
+	compiled = precompile(getfield(m, name), (self_type, argument_types...))
+	entry_point_name = Symbol("#godot_callback#", name)
+	if isdefined(m, entry_point_name)
+		compiled &= precompile(getfield(m, entry_point_name), (Any, argument_types...))
+	end
+	return compiled
+end
+
+# Sysimage.
+
+# The script modules which were evaluated when building the sysimage, by the hash of their source.
+const baked_modules = Dict{UInt, Module}()
+
+"""
+Return the script module which was baked into the sysimage for the given source, or `nothing` if there is none (e.g.
+because the source changed since the sysimage was built).
+"""
+load_baked_module(source::String) = get(baked_modules, hash(source), nothing)
+
+"""
+Build a sysimage at `sysimage_path` containing Godot.jl and the script modules of the project, using PackageCompiler.
+`paths` are the paths of the script files, and `res_paths` their paths in the project. If `precompile_statements_path`
+is not empty, the precompile statements which it contains (e.g. recorded with `--julia-trace-compile`) are compiled
+into the sysimage.
+"""
+function build_sysimage(sysimage_path::String, paths::Vector, res_paths::Vector, precompile_statements_path::String)
+	# NOTE: PackageCompiler is not a dependency of Godot.jl, since it's only needed to export projects.
+	package_compiler = Base.require(Base.PkgId(Base.UUID("9b87118b-4619-50d2-8e1e-99f35a4d4d9d"), "PackageCompiler"))
+
+	# The script runs in the process which outputs the sysimage, so the modules it evaluates are part of the image.
+	build_script = tempname() * ".jl"
+	open(build_script, "w") do io
+		println(io, "import Godot")
+		for (path, res_path) in zip(paths, res_paths)
+			println(io, "let source = read($(repr(path)), String), m = include_string(Main, source, $(repr(res_path)))")
+			println(io, "\tm isa Module && (Godot.Runtime.baked_modules[hash(source)] = m)")
+			println(io, "end")
+		end
+	end
+
+	precompile_statements_files = isempty(precompile_statements_path) ? String[] : [precompile_statements_path]
+	Base.invokelatest(package_compiler.create_sysimage, ["Godot"];
+		sysimage_path, script = build_script, precompile_statements_file = precompile_statements_files)
+	rm(build_script; force = true)
+	return nothing
+end
+
+# Script cache.
+
+"""
+Load the script module defined by `source` as a package in the directory `cache_path`, so that Julia precompiles it
+and caches its native code on disk, to be reused by later runs as long as the source and Godot.jl don't change.
+
+Returns `nothing` if the source doesn't consist of exactly one module, or if a module with the same name was already
+loaded as a package in this session (e.g. when the script is reloaded after editing), so that the caller evaluates it
+instead.
+"""
+function load_cached_module(source::String, file_name::String, cache_path::String)
+	expressions = filter(e -> !(e isa LineNumberNode), Meta.parseall(source; filename = file_name).args)
+	length(expressions) == 1 || return nothing
+	expression = only(expressions)
+	(expression isa Expr && expression.head === :module) || return nothing
+	name = expression.args[2]
+	name isa Symbol || return nothing
+
+	package_id = Base.PkgId(String(name))
+	haskey(Base.loaded_modules, package_id) && return nothing
+
+	# Julia invalidates its cache when the file changes, so it's only written when the source or Godot.jl changed.
+	# The trailer comes last to keep the line numbers of the source.
+	package_source = string(source, "\n# Cached from $file_name by Godot.jl $(pkgversion(parentmodule(@__MODULE__)))\n")
+	package_path = joinpath(cache_path, String(name), "src", "$name.jl")
+	if !isfile(package_path) || read(package_path, String) != package_source
+		mkpath(dirname(package_path))
+		write(package_path, package_source)
+	end
+
+	cache_path in LOAD_PATH || push!(LOAD_PATH, cache_path)
+	return Base.require(package_id)
+end
+
+# Sampling profiler.
+
+"""
+Start Julia's sampling profiler, taking a sample of the stacks of all Julia threads every `interval` seconds.
+"""
+function start_sampling(interval::Float64)
+	Profile.clear()
+	Profile.init(n = 10^7, delay = interval)
+	Profile.start_timer()
+	return nothing
+end
+
+"""
+Stop the sampling profiler and write the samples to `path` as folded stacks, i.e. one line per distinct stack with
+semicolon-separated frames from the root to the leaf followed by the number of samples, which is the input format of
+flame graph tools such as `flamegraph.pl` and speedscope.
+
+Script functions show up with the `res://` path and line of the sample. Native frames are kept, so that the time spent
+inside the engine (e.g. in a method called through `ptrcall`) shows up above the Julia frame that called it.
+"""
+function stop_sampling(path::String)
+	Profile.stop_timer()
+	data = Profile.fetch(include_meta = false)
+	lidict = Profile.getdict(data)
+	stacks = Dict{Vector{String}, Int}()
+	stack = String[]
+	for ip in data
+		if ip == 0
+			# The end of a backtrace, which lists the frames from the leaf to the root.
+			if !isempty(stack)
+				key = reverse(stack)
+				stacks[key] = get(stacks, key, 0) + 1
+				empty!(stack)
+			end
+			continue
+		end
+		# One instruction pointer may stand for several frames when functions were inlined, innermost first.
+		for frame in lidict[ip]
+			push!(stack, folded_frame_name(frame))
+		end
+	end
+	open(path, "w") do io
+		for (key, count) in stacks
+			join(io, key, ';')
+			println(io, ' ', count)
+		end
+	end
+	Profile.clear()
+	return length(stacks)
+end
+
+function folded_frame_name(frame::Base.StackTraces.StackFrame)
+	name = frame.func === Symbol("") ? "unknown" : String(frame.func)
+	# Semicolons separate the frames.
+	return replace("$name ($(frame.file):$(frame.line))", ';' => ',')
+end
+
+end # module
@@ -1,10 +1,67 @@
 mutable struct GodotString
 	cowdata::Ptr{Char}
-	function GodotString(string::String)
-		chars = transcode(UInt16, string * '\0')
+	function GodotString(string::Union{String, SubString{String}})
 		godot_string = new(C_NULL)
-		@ccall godot_julia_string_new_from_utf16_chars(godot_string::Ref{GodotString}, chars::Ref{UInt16})::Cvoid
-		destroy_string(s) = @ccall godot_julia_string_destroy(s::Ref{GodotString})::Cvoid
+		# The engine decodes the UTF-8 code units in place, so this is the only copy.
+		GC.@preserve string begin
+			@ccall godot_julia_string_new_from_utf8_chars_and_len(godot_string::Ref{GodotString}, pointer(string)::Ptr{UInt8}, ncodeunits(string)::Int64)::Cvoid
+		end
 		finalizer(destroy_string, godot_string)
 	end
+	# An empty String of the engine is a null pointer.
+	GodotString() = finalizer(destroy_string, new(C_NULL))
 end
+
+GodotString(string::AbstractString) = GodotString(String(string))
+
+destroy_string(s::GodotString) = @ccall godot_julia_string_destroy(s::Ref{GodotString})::Cvoid
+
+# Invalid code points (e.g. unpaired surrogates) become the replacement character.
+utf8_code_point(c::UInt32) = (c < 0xd800 || 0xdfff < c <= 0x10ffff) ? c : UInt32(0xfffd)
+
+utf8_length(c::UInt32) = c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4
+
+"""
+	String(s::GodotString)
+
+Convert the engine's String `s` (which is UTF-32) to a Julia `String`, encoding it directly from the engine's buffer.
+"""
+function Base.String(s::GodotString)
+	char_count = Ref{Int64}(0)
+	GC.@preserve s begin
+		chars = @ccall godot_julia_string_get_utf32_chars(s::Ref{GodotString}, char_count::Ref{Int64})::Ptr{UInt32}
+		byte_count = 0
+		for i in 1:char_count[]
+			byte_count += utf8_length(utf8_code_point(unsafe_load(chars, i)))
+		end
+		bytes = Base.StringVector(byte_count)
+		j = 1
+		@inbounds for i in 1:char_count[]
+			c = utf8_code_point(unsafe_load(chars, i))
+			if c < 0x80
+				bytes[j] = c % UInt8
+				j += 1
+			elseif c < 0x800
+				bytes[j] = (0xc0 | (c >> 6)) % UInt8
+				bytes[j+1] = (0x80 | (c & 0x3f)) % UInt8
+				j += 2
+			elseif c < 0x10000
+				bytes[j] = (0xe0 | (c >> 12)) % UInt8
+				bytes[j+1] = (0x80 | ((c >> 6) & 0x3f)) % UInt8
+				bytes[j+2] = (0x80 | (c & 0x3f)) % UInt8
+				j += 3
+			else
+				bytes[j] = (0xf0 | (c >> 18)) % UInt8
+				bytes[j+1] = (0x80 | ((c >> 12) & 0x3f)) % UInt8
+				bytes[j+2] = (0x80 | ((c >> 6) & 0x3f)) % UInt8
+				bytes[j+3] = (0x80 | (c & 0x3f)) % UInt8
+				j += 4
+			end
+		end
+	end
+	# Takes ownership of the bytes without copying them.
+	return String(bytes)
+end
+
+Base.convert(::Type{GodotString}, s::AbstractString) = GodotString(s)
+Base.convert(::Type{String}, s::GodotString) = String(s)
@@ -3,17 +3,81 @@ mutable struct StringName
 	function StringName(godot_string::GodotString)
 		string_name = new(C_NULL)
 		@ccall godot_julia_string_name_new_from_string(string_name::Ref{StringName}, godot_string::Ref{GodotString})::Cvoid
-		destroy_string_name(s) = @ccall godot_julia_string_name_destroy(s::Ref{StringName})::Cvoid
 		finalizer(destroy_string_name, string_name)
 	end
 	StringName(string::String) = StringName(GodotString(string))
+	# An empty StringName of the engine is a null pointer.
+	StringName() = finalizer(destroy_string_name, new(C_NULL))
 end
 
-string_names = Dict{Symbol, StringName}()
+destroy_string_name(s::StringName) = @ccall godot_julia_string_name_destroy(s::Ref{StringName})::Cvoid
 
-function get_string_name!(s::Symbol)
-	global string_names
-	get!(string_names, s) do
-		StringName(GodotString(String(s)))
+# NOTE: StringNames must not be cached while precompiling, since the engine's pointers don't outlive the process.
+generating_output() = ccall(:jl_generating_output, Cint, ()) == 1
+
+"""
+A StringName which is created on first use and then reused, for a `sn"..."` literal.
+"""
+mutable struct StringNameSlot
+	name::String
+	@atomic value::Union{Nothing, StringName}
+	StringNameSlot(name::String) = new(name, nothing)
+end
+
+@inline function string_name(slot::StringNameSlot)
+	value = @atomic :acquire slot.value
+	value === nothing || return value
+	return fill_string_name_slot!(slot)
+end
+
+@noinline function fill_string_name_slot!(slot::StringNameSlot)
+	value = StringName(slot.name)
+	generating_output() && return value
+	# When several threads fill the slot at once, they all use the first value.
+	old, success = @atomicreplace :acquire_release :acquire slot.value nothing => value
+	return success ? value : old::StringName
+end
+
+"""
+	sn"name"
+
+A `StringName` literal, e.g. `Input.is_action_pressed(sn"ui_accept")`. The StringName is created the first time the
+expression runs, and reused afterwards, without locking.
+"""
+macro sn_str(name::String)
+	return :(string_name($(StringNameSlot(name))))
+end
+
+# The StringNames of get_string_name!. The dictionary is replaced (never modified) when a name is added, so reading it
+# doesn't need a lock.
+mutable struct StringNames
+	@atomic table::Dict{Symbol, StringName}
+end
+
+const string_names = StringNames(Dict{Symbol, StringName}())
+const string_names_lock = ReentrantLock()
+
+"""
+Return the StringName for the symbol `s`, creating it on first use. Prefer `sn"..."` for names which are known when
+writing the code, since adding a name copies the table.
+"""
+@inline function get_string_name!(s::Symbol)
+	table = @atomic :acquire string_names.table
+	value = get(table, s, nothing)
+	value === nothing || return value
+	return add_string_name!(s)
+end
+
+@noinline function add_string_name!(s::Symbol)
+	lock(string_names_lock) do
+		table = @atomic :acquire string_names.table
+		value = get(table, s, nothing)
+		value === nothing || return value
+		value = StringName(String(s))
+		generating_output() && return value
+		new_table = copy(table)
+		new_table[s] = value
+		@atomic :release string_names.table = new_table
+		return value
 	end
 end
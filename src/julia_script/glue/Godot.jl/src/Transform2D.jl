@@ -0,0 +1,20 @@
+include("generated/core_constants.jl")
+
+"""
+A 2×3 matrix (2 rows, 3 columns) used for 2D linear transformations.
+"""
+struct Transform2D
+    x::Vector2
+    y::Vector2
+    origin::Vector2
+end
+
+# Display.
+
+function Base.show(io::Core.IO, t::Transform2D)
+    print(io, "Transform2D(", t.x, ", ", t.y, ", ", t.origin, ")")
+end
+
+# Constructors.
+
+Transform2D() = Transform2D(Vector2(1, 0), Vector2(0, 1), Vector2(0, 0))
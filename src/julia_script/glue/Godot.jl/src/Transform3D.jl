@@ -0,0 +1,17 @@
+"""
+A 3×4 matrix (3 rows, 4 columns) used for 3D linear transformations.
+"""
+struct Transform3D
+    basis::Basis
+    origin::Vector3
+end
+
+# Display.
+
+function Base.show(io::Core.IO, t::Transform3D)
+    print(io, "Transform3D(", t.basis, ", ", t.origin, ")")
+end
+
+# Constructors.
+
+Transform3D() = Transform3D(Basis(), Vector3())
@@ -4,7 +4,12 @@ abstract type GodotVariant end
 
 mutable struct Variant <: GodotVariant
 	data::NTuple{VARIANT_SIZE, UInt8}
-	Variant() = new(tuple(zeros(UInt8, VARIANT_SIZE)...))
+	function Variant()
+		variant = new(tuple(zeros(UInt8, VARIANT_SIZE)...))
+		finalizer(destroy_variant, variant)
+	end
 end
 
+destroy_variant(v::Variant) = @ccall godot_julia_variant_destroy(v::Ref{Variant})::Cvoid
+
 variant_type(v::Variant) = VariantType(v.data[1])
@@ -1,10 +1,39 @@
 #include "godot_julia.h"
 
+#include "../julia_language.h"
+
 #include "core/config/engine.h"
 #include "core/object/class_db.h"
 #include "core/object/method_bind.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/string_name.h"
 #include "core/typedefs.h"
+#include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
+
+// The packed arrays whose elements can be viewed from Julia without copying.
+#define GODOT_JULIA_PACKED_ARRAY_TYPES(m_type)      \
+	m_type(PACKED_BYTE_ARRAY, get_byte_array)       \
+	m_type(PACKED_INT32_ARRAY, get_int32_array)     \
+	m_type(PACKED_INT64_ARRAY, get_int64_array)     \
+	m_type(PACKED_FLOAT32_ARRAY, get_float32_array) \
+	m_type(PACKED_FLOAT64_ARRAY, get_float64_array) \
+	m_type(PACKED_VECTOR2_ARRAY, get_vector2_array) \
+	m_type(PACKED_VECTOR3_ARRAY, get_vector3_array) \
+	m_type(PACKED_COLOR_ARRAY, get_color_array)     \
+	m_type(PACKED_VECTOR4_ARRAY, get_vector4_array)
+
+struct GodotJuliaGroupTask {
+	void (*function)(void *, uint32_t);
+	void *userdata;
+};
+
+// Runs a Julia callback of a group task on a worker thread of the WorkerThreadPool, which must enter the Julia runtime.
+static void _godot_julia_group_task(void *p_userdata, uint32_t p_index) {
+	GodotJuliaGroupTask *task = (GodotJuliaGroupTask *)p_userdata;
+	JuliaThreadScope thread_scope;
+	task->function(task->userdata, p_index);
+}
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,6 +44,18 @@ GJ_API void godot_julia_string_new_from_utf16_chars(String *r_string, const char
 	r_string->append_utf16(p_chars);
 }
 
+GJ_API void godot_julia_string_new_from_utf8_chars_and_len(String *r_string, const char *p_chars, int64_t p_length) {
+	memnew_placement(r_string, String());
+	ERR_FAIL_COND(p_length < 0 || p_length > INT32_MAX);
+	r_string->append_utf8(p_chars, p_length);
+}
+
+GJ_API const char32_t *godot_julia_string_get_utf32_chars(const String *p_string, int64_t *r_length) {
+	// The length excludes the null terminator. An empty String has no buffer.
+	*r_length = p_string->length();
+	return p_string->ptr();
+}
+
 GJ_API void godot_julia_string_destroy(String *p_string) {
 	p_string->~String();
 }
@@ -27,6 +68,72 @@ GJ_API void godot_julia_string_name_destroy(StringName *p_string_name) {
 	p_string_name->~StringName();
 }
 
+GJ_API void godot_julia_variant_destroy(Variant *p_variant) {
+	p_variant->~Variant();
+}
+
+GJ_API void godot_julia_packed_array_initialize(Variant *p_variant, int64_t p_type) {
+	VariantInternal::initialize(p_variant, (Variant::Type)p_type);
+}
+
+GJ_API const void *godot_julia_packed_array_ptr(Variant *p_variant, int64_t *r_size) {
+	switch (p_variant->get_type()) {
+#define GODOT_JULIA_PACKED_ARRAY_PTR(m_type, m_getter)          \
+	case Variant::m_type: {                                     \
+		*r_size = VariantInternal::m_getter(p_variant)->size(); \
+		return VariantInternal::m_getter(p_variant)->ptr();     \
+	}
+		GODOT_JULIA_PACKED_ARRAY_TYPES(GODOT_JULIA_PACKED_ARRAY_PTR)
+#undef GODOT_JULIA_PACKED_ARRAY_PTR
+		default: {
+			*r_size = 0;
+			ERR_FAIL_V_MSG(nullptr, "The Variant is not a packed array with viewable elements.");
+		}
+	}
+}
+
+GJ_API void *godot_julia_packed_array_ptrw(Variant *p_variant) {
+	// NOTE: This copies the data if it is shared with other packed arrays.
+	switch (p_variant->get_type()) {
+#define GODOT_JULIA_PACKED_ARRAY_PTRW(m_type, m_getter) \
+	case Variant::m_type:                                \
+		return VariantInternal::m_getter(p_variant)->ptrw();
+		GODOT_JULIA_PACKED_ARRAY_TYPES(GODOT_JULIA_PACKED_ARRAY_PTRW)
+#undef GODOT_JULIA_PACKED_ARRAY_PTRW
+		default: {
+			ERR_FAIL_V_MSG(nullptr, "The Variant is not a packed array with viewable elements.");
+		}
+	}
+}
+
+GJ_API void godot_julia_packed_array_resize(Variant *p_variant, int64_t p_size) {
+	switch (p_variant->get_type()) {
+#define GODOT_JULIA_PACKED_ARRAY_RESIZE(m_type, m_getter)     \
+	case Variant::m_type: {                                   \
+		VariantInternal::m_getter(p_variant)->resize(p_size); \
+	} break;
+		GODOT_JULIA_PACKED_ARRAY_TYPES(GODOT_JULIA_PACKED_ARRAY_RESIZE)
+#undef GODOT_JULIA_PACKED_ARRAY_RESIZE
+		default: {
+			ERR_FAIL_MSG("The Variant is not a packed array with viewable elements.");
+		}
+	}
+}
+
+GJ_API void *godot_julia_packed_array_vector(Variant *p_variant) {
+	// The Vector<T> which ptrcall expects for packed array arguments and return values.
+	switch (p_variant->get_type()) {
+#define GODOT_JULIA_PACKED_ARRAY_VECTOR(m_type, m_getter) \
+	case Variant::m_type:                                  \
+		return VariantInternal::m_getter(p_variant);
+		GODOT_JULIA_PACKED_ARRAY_TYPES(GODOT_JULIA_PACKED_ARRAY_VECTOR)
+#undef GODOT_JULIA_PACKED_ARRAY_VECTOR
+		default: {
+			ERR_FAIL_V_MSG(nullptr, "The Variant is not a packed array with viewable elements.");
+		}
+	}
+}
+
 GJ_API MethodBind *godot_julia_get_method_bind(const StringName *p_classname, const StringName *p_methodname) {
 	return ClassDB::get_method(*p_classname, *p_methodname);
 }
@@ -35,10 +142,37 @@ GJ_API void godot_julia_method_bind_ptrcall(MethodBind *p_method_bind, Object *p
 	p_method_bind->ptrcall(p_instance, p_args, p_ret);
 }
 
+GJ_API void godot_julia_method_bind_ptrcall_gc_safe(MethodBind *p_method_bind, Object *p_instance, const void **p_args, void *p_ret) {
+	// The arguments and the return value are rooted by the caller, so a collection may run while the engine method does.
+	JuliaGCSafeScope gc_safe_scope;
+	p_method_bind->ptrcall(p_instance, p_args, p_ret);
+}
+
+GJ_API void godot_julia_method_bind_ptrcall_batch(MethodBind *p_method_bind, Object *const *p_instances, int64_t p_count, const void **p_args, int64_t p_argcount, uint8_t *p_rets, int64_t p_ret_size) {
+	// The arguments of the i-th call start at p_args[i * p_argcount], and its return value is at p_rets[i * p_ret_size].
+	for (int64_t i = 0; i < p_count; i++) {
+		ERR_CONTINUE_MSG(!p_instances[i], "Cannot call a method on a null instance.");
+		p_method_bind->ptrcall(p_instances[i], p_args + i * p_argcount, p_rets ? p_rets + i * p_ret_size : nullptr);
+	}
+}
+
 GJ_API Object *godot_julia_get_singleton(const StringName *p_classname) {
 	return Engine::get_singleton()->get_singleton_object(*p_classname);
 }
 
+GJ_API int64_t godot_julia_worker_thread_pool_get_thread_count() {
+	return WorkerThreadPool::get_singleton()->get_thread_count();
+}
+
+GJ_API void godot_julia_worker_thread_pool_run_group_task(void (*p_function)(void *, uint32_t), void *p_userdata, int64_t p_elements, bool p_high_priority) {
+	ERR_FAIL_COND(p_elements < 0 || p_elements > INT32_MAX);
+	GodotJuliaGroupTask task = { p_function, p_userdata };
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_godot_julia_group_task, &task, p_elements, -1, p_high_priority, "Julia group task");
+	// The callbacks allocate on the worker threads, so a collection must not wait for this thread while it blocks.
+	JuliaGCSafeScope gc_safe_scope;
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,9 +1,40 @@
 #include "julia_language.h"
 
+#include "julia_runtime.h"
 #include "julia_script.h"
+#include "julia_variant.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "main/performance.h"
+
+#include <julia_gcext.h>
 
 JuliaLanguage *JuliaLanguage::singleton = nullptr;
 
+SafeNumeric<uint64_t> JuliaLanguage::gc_pause_count;
+SafeNumeric<uint64_t> JuliaLanguage::gc_pause_usec;
+uint64_t JuliaLanguage::gc_pause_start_usec = 0;
+
+static const char *monitor_names[] = {
+	"Julia/Heap Size",
+	"Julia/Allocated Bytes",
+	"Julia/GC Pauses",
+	"Julia/GC Pause Time (ms)",
+	"Julia/Compile Time (ms)",
+};
+
+String julia_exception_string(jl_value_t *p_exception) {
+	jl_value_t *exception_str = nullptr;
+	JL_GC_PUSH2(&p_exception, &exception_str);
+	exception_str = jl_call2(jl_get_function(jl_base_module, "sprint"), jl_get_function(jl_base_module, "showerror"), p_exception);
+	String result = exception_str ? String::utf8(jl_string_ptr(exception_str), jl_string_len(exception_str)) : String("(the exception could not be shown)");
+	JL_GC_POP();
+	return result;
+}
+
 void JuliaLanguage::_bind_methods() {
 }
 
@@ -11,9 +42,174 @@ String JuliaLanguage::get_name() const {
 	return "Julia";
 }
 
+bool JuliaLanguage::initialize_runtime() {
+	if (likely(runtime_initialized.is_set())) {
+		return true;
+	}
+
+	MutexLock lock(runtime_mutex);
+	if (runtime_initialized.is_set()) {
+		return true;
+	}
+
+	// The options are passed like those on the command line of julia, and must outlive the runtime.
+	runtime_options.clear();
+	runtime_options.push_back(String("godot").utf8());
+	int threads = GLOBAL_GET("julia/runtime/threads");
+	runtime_options.push_back(("--threads=" + (threads > 0 ? itos(threads) : String("auto"))).utf8());
+	runtime_options.push_back(("--optimize=" + itos(int(GLOBAL_GET("julia/runtime/optimization_level")))).utf8());
+	static const char *compile_modes[] = { "yes", "no", "all", "min" };
+	int compile_mode = CLAMP(int(GLOBAL_GET("julia/runtime/compile_mode")), 0, 3);
+	runtime_options.push_back((String("--compile=") + compile_modes[compile_mode]).utf8());
+	// Record the methods which get compiled, e.g. to compile them into the sysimage: --julia-trace-compile <path>
+	const List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--julia-trace-compile" && E->next()) {
+			runtime_options.push_back(("--trace-compile=" + E->next()->get()).utf8());
+		}
+	}
+
+	LocalVector<char *> argv;
+	for (CharString &option : runtime_options) {
+		argv.push_back(option.ptrw());
+	}
+	int argc = argv.size();
+	char **argv_ptr = argv.ptr();
+	jl_parse_opts(&argc, &argv_ptr);
+
+	// The sysimage of the project settings, or else the one which the export plugin built, if it was shipped next to
+	// the executable, or else Julia's default sysimage.
+	String sysimage_path = GLOBAL_GET("julia/runtime/sysimage_path");
+	if (!sysimage_path.is_empty()) {
+		sysimage_path = ProjectSettings::get_singleton()->globalize_path(sysimage_path);
+	} else {
+#if defined(WINDOWS_ENABLED)
+		const String sysimage_extension = "dll";
+#elif defined(MACOS_ENABLED)
+		const String sysimage_extension = "dylib";
+#else
+		const String sysimage_extension = "so";
+#endif
+		String exported_sysimage_path = OS::get_singleton()->get_executable_path().get_base_dir().path_join(String(JULIA_SYSIMAGE_BASENAME) + "." + sysimage_extension);
+		if (FileAccess::exists(exported_sysimage_path)) {
+			sysimage_path = exported_sysimage_path;
+		}
+	}
+	runtime_sysimage_path = sysimage_path.utf8();
+
+	// The same as jl_init(), except for the sysimage.
+	runtime_bindir = String::utf8(jl_get_libdir()).path_join("..").path_join("bin").utf8();
+	jl_init_with_image(runtime_bindir.get_data(), sysimage_path.is_empty() ? nullptr : runtime_sysimage_path.get_data());
+	print_verbose("Initialized the Julia runtime" + (sysimage_path.is_empty() ? String() : " with the sysimage " + sysimage_path));
+
+	jl_gc_get_total_bytes(&gc_pacing.last_total_bytes);
+
+	jl_gc_set_cb_pre_gc(_gc_pre_callback, 1);
+	jl_gc_set_cb_post_gc(_gc_post_callback, 1);
+	jl_gc_get_total_bytes(&monitors.last_total_bytes);
+#ifdef DEBUG_ENABLED
+	// Also needed to report compile hitches.
+	_enable_compile_timing();
+#else
+	if (monitors.compile_time_read) {
+		_enable_compile_timing();
+	}
+#endif
+
+	// Like the threads adopted later, this thread waits in a GC-safe state while it runs engine code.
+	jl_gc_safe_enter(jl_get_current_task()->ptls);
+
+	runtime_initialized.set();
+	return true;
+}
+
+bool JuliaLanguage::load_godot_module() {
+	if (!initialize_runtime()) {
+		return false;
+	}
+
+	{
+		JuliaGCSafeScope gc_safe_scope;
+		godot_module_mutex.lock();
+	}
+	bool loaded;
+	{
+		JuliaThreadScope thread_scope;
+		loaded = _load_godot_module();
+	}
+	godot_module_mutex.unlock();
+	return loaded;
+}
+
+bool JuliaLanguage::_load_godot_module() {
+	if (godot_runtime_module) {
+		return true;
+	}
+
+	jl_value_t *godot_module_maybe = jl_eval_string("import Godot; Godot");
+	if (jl_exception_occurred()) {
+		ERR_FAIL_V_MSG(false, String("Failed to load the Julia package Godot.jl: ") + julia_exception_string());
+	}
+	ERR_FAIL_COND_V_MSG(!jl_is_module(godot_module_maybe), false, "The Julia package Godot.jl does not define a module");
+
+	// NOTE: The modules are rooted by the binding of Godot in Main.
+	godot_module = (jl_module_t *)godot_module_maybe;
+	godot_runtime_module = (jl_module_t *)jl_get_global(godot_module, jl_symbol("Runtime"));
+	ERR_FAIL_COND_V_MSG(!godot_runtime_module || !jl_is_module(godot_runtime_module), false, "The Julia package Godot.jl does not have a Runtime module");
+
+	runtime_functions.script_functions = jl_get_function(godot_runtime_module, "script_functions");
+	runtime_functions.callback_cfunction = jl_get_function(godot_runtime_module, "callback_cfunction");
+	runtime_functions.new_instances = jl_get_function(godot_runtime_module, "new_instances");
+	runtime_functions.warm_up_callback = jl_get_function(godot_runtime_module, "warm_up_callback");
+	runtime_functions.load_cached_module = jl_get_function(godot_runtime_module, "load_cached_module");
+	runtime_functions.load_baked_module = jl_get_function(godot_runtime_module, "load_baked_module");
+	runtime_functions.build_sysimage = jl_get_function(godot_runtime_module, "build_sysimage");
+	runtime_functions.start_sampling = jl_get_function(godot_runtime_module, "start_sampling");
+	runtime_functions.stop_sampling = jl_get_function(godot_runtime_module, "stop_sampling");
+
+	julia_variant_initialize_types(godot_module);
+
+	if (sampling.enabled) {
+		_start_sampling();
+	}
+
+	return true;
+}
+
 /* LANGUAGE FUNCTIONS */
 
 void JuliaLanguage::init() {
+	gc_pacing.enabled = GLOBAL_GET("julia/gc/pacing_enabled");
+	gc_pacing.frame_budget_usec = uint64_t(double(GLOBAL_GET("julia/gc/frame_budget_msec")) * 1000.0);
+	gc_pacing.heap_limit = int64_t(GLOBAL_GET("julia/gc/heap_limit_mb")) * 1024 * 1024;
+
+	compilation.deferred_loading = GLOBAL_GET("julia/compilation/deferred_loading");
+#ifdef TOOLS_ENABLED
+	// Packages can't be redefined within a session, so edited scripts are always evaluated in the editor.
+	compilation.cache_scripts = !Engine::get_singleton()->is_editor_hint() && bool(GLOBAL_GET("julia/compilation/cache_scripts"));
+#else
+	compilation.cache_scripts = GLOBAL_GET("julia/compilation/cache_scripts");
+#endif
+	compilation.cache_path = ProjectSettings::get_singleton()->globalize_path(GLOBAL_GET("julia/compilation/cache_path"));
+	compilation.warm_up_callbacks = GLOBAL_GET("julia/compilation/warm_up_callbacks");
+#ifdef DEBUG_ENABLED
+	compilation.report_hitches = GLOBAL_GET("julia/compilation/report_hitches");
+	compilation.hitch_threshold_nsec = uint64_t(double(GLOBAL_GET("julia/compilation/hitch_threshold_msec")) * 1000000.0);
+#endif
+
+	sampling.enabled = GLOBAL_GET("julia/profiler/sampling_enabled");
+	sampling.interval_msec = GLOBAL_GET("julia/profiler/sampling_interval_msec");
+	sampling.output_path = GLOBAL_GET("julia/profiler/sampling_output_path");
+	// The command line overrides the project settings, e.g. for headless runs: --julia-sampling-profile <path>
+	const List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (E->get() == "--julia-sampling-profile" && E->next()) {
+			sampling.enabled = true;
+			sampling.output_path = E->next()->get();
+		}
+	}
+
+	_register_monitors();
 }
 
 String JuliaLanguage::get_type() const {
@@ -25,6 +221,22 @@ String JuliaLanguage::get_extension() const {
 }
 
 void JuliaLanguage::finish() {
+	_unregister_monitors();
+
+	if (!runtime_initialized.is_set()) {
+		return;
+	}
+	JuliaThreadScope thread_scope;
+
+	_stop_loader_thread();
+	_stop_sampling();
+
+	jl_gc_set_cb_pre_gc(_gc_pre_callback, 0);
+	jl_gc_set_cb_post_gc(_gc_post_callback, 0);
+	if (monitors.compile_timing) {
+		monitors.compile_timing = false;
+		jl_cumulative_compile_timing_disable();
+	}
 }
 
 /* EDITOR FUNCTIONS */
@@ -92,9 +304,15 @@ void JuliaLanguage::remove_named_global_constant(const StringName &p_name) {
 /* MULTITHREAD FUNCTIONS */
 
 void JuliaLanguage::thread_enter() {
+	// Threads which start before the runtime is initialized are adopted when they first run Julia code instead.
+	if (runtime_initialized.is_set()) {
+		adopt_current_thread();
+	}
 }
 
 void JuliaLanguage::thread_exit() {
+	// NOTE: The runtime releases the state of an adopted thread when the thread exits. Until then the thread stays in
+	// its GC-safe state, so it doesn't hold up collections.
 }
 
 /* DEBUGGER FUNCTIONS */
@@ -161,23 +379,387 @@ void JuliaLanguage::get_public_annotations(List<MethodInfo> *p_annotations) cons
 }
 
 void JuliaLanguage::profiling_start() {
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	for (SelfList<JuliaScript> *E = script_list.first(); E; E = E->next()) {
+		JuliaScript::StateRef state = E->self()->_get_state();
+		if (!state.is_valid()) {
+			continue;
+		}
+		profile_lock.lock();
+		for (KeyValue<StringName, JuliaScript::Function> &F : state->functions) {
+			JuliaScript::Function::Profile &profile = F.value.profile;
+			StringName signature = profile.signature;
+			profile = JuliaScript::Function::Profile();
+			profile.signature = signature;
+		}
+		profile_lock.unlock();
+	}
+
+	profiling.set();
+#endif
 }
 
 void JuliaLanguage::profiling_stop() {
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	profiling.clear();
+#endif
 }
 
 void JuliaLanguage::profiling_set_save_native_calls(bool p_enable) {
+	// Only script functions are timed; engine methods called from Julia are part of their self time.
 }
 
 int JuliaLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
-	return 0;
+	int current = 0;
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	for (SelfList<JuliaScript> *E = script_list.first(); E; E = E->next()) {
+		JuliaScript::StateRef state = E->self()->_get_state();
+		if (!state.is_valid()) {
+			continue;
+		}
+		for (KeyValue<StringName, JuliaScript::Function> &F : state->functions) {
+			if (current >= p_info_max) {
+				return current;
+			}
+			// Copied, since callbacks on other threads may be updating it.
+			profile_lock.lock();
+			const JuliaScript::Function::Profile profile = F.value.profile;
+			profile_lock.unlock();
+			if (profile.call_count == 0) {
+				continue;
+			}
+			p_info_arr[current].signature = profile.signature;
+			p_info_arr[current].call_count = profile.call_count;
+			p_info_arr[current].self_time = profile.self_time;
+			p_info_arr[current].total_time = profile.total_time;
+			current++;
+		}
+	}
+#endif
+	return current;
 }
 
 int JuliaLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) {
-	return 0;
+	int current = 0;
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	for (SelfList<JuliaScript> *E = script_list.first(); E; E = E->next()) {
+		JuliaScript::StateRef state = E->self()->_get_state();
+		if (!state.is_valid()) {
+			continue;
+		}
+		for (KeyValue<StringName, JuliaScript::Function> &F : state->functions) {
+			if (current >= p_info_max) {
+				return current;
+			}
+			// Copied, since callbacks on other threads may be updating it.
+			profile_lock.lock();
+			const JuliaScript::Function::Profile profile = F.value.profile;
+			profile_lock.unlock();
+			if (profile.last_frame_call_count == 0) {
+				continue;
+			}
+			p_info_arr[current].signature = profile.signature;
+			p_info_arr[current].call_count = profile.last_frame_call_count;
+			p_info_arr[current].self_time = profile.last_frame_self_time;
+			p_info_arr[current].total_time = profile.last_frame_total_time;
+			current++;
+		}
+	}
+#endif
+	return current;
+}
+
+void JuliaLanguage::_gc_pre_callback(int p_full) {
+	// NOTE: The world is stopped during a collection, so only the collecting thread gets here.
+	gc_pause_start_usec = OS::get_singleton()->get_ticks_usec();
+}
+
+void JuliaLanguage::_gc_post_callback(int p_full) {
+	gc_pause_usec.add(OS::get_singleton()->get_ticks_usec() - gc_pause_start_usec);
+	gc_pause_count.increment();
+}
+
+void JuliaLanguage::_register_monitors() {
+	Performance *performance = Performance::get_singleton();
+	ERR_FAIL_NULL(performance);
+
+	for (int i = 0; i < MONITOR_MAX; i++) {
+		Vector<Variant> args;
+		args.push_back(i);
+		performance->add_custom_monitor(monitor_names[i], callable_mp(this, &JuliaLanguage::_get_monitor), args);
+	}
+	monitors.registered = true;
+}
+
+void JuliaLanguage::_unregister_monitors() {
+	if (!monitors.registered) {
+		return;
+	}
+	monitors.registered = false;
+
+	Performance *performance = Performance::get_singleton();
+	if (performance) {
+		for (int i = 0; i < MONITOR_MAX; i++) {
+			if (performance->has_custom_monitor(monitor_names[i])) {
+				performance->remove_custom_monitor(monitor_names[i]);
+			}
+		}
+	}
+}
+
+void JuliaLanguage::_sample_monitors() {
+	// The monitors other than the heap size are per frame.
+	int64_t total_bytes = 0;
+	jl_gc_get_total_bytes(&total_bytes);
+	monitors.values[MONITOR_ALLOCATED_BYTES] = double(total_bytes - monitors.last_total_bytes);
+	monitors.last_total_bytes = total_bytes;
+
+	monitors.values[MONITOR_HEAP_SIZE] = double(jl_gc_live_bytes());
+
+	uint64_t pause_count = gc_pause_count.get();
+	monitors.values[MONITOR_GC_PAUSES] = double(pause_count - monitors.last_gc_pause_count);
+	monitors.last_gc_pause_count = pause_count;
+
+	uint64_t pause_usec = gc_pause_usec.get();
+	monitors.values[MONITOR_GC_PAUSE_TIME] = double(pause_usec - monitors.last_gc_pause_usec) / 1000.0;
+	monitors.last_gc_pause_usec = pause_usec;
+
+	uint64_t compile_time_nsec = jl_cumulative_compile_time_ns();
+	monitors.values[MONITOR_COMPILE_TIME] = double(compile_time_nsec - monitors.last_compile_time_nsec) / 1000000.0;
+	monitors.last_compile_time_nsec = compile_time_nsec;
+}
+
+void JuliaLanguage::_enable_compile_timing() {
+	monitors.compile_timing = true;
+	jl_cumulative_compile_timing_enable();
+	monitors.last_compile_time_nsec = jl_cumulative_compile_time_ns();
+}
+
+double JuliaLanguage::_get_monitor(int p_monitor) {
+	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, 0.0);
+	if (unlikely(p_monitor == MONITOR_COMPILE_TIME && !monitors.compile_time_read)) {
+		MutexLock lock(runtime_mutex);
+		monitors.compile_time_read = true;
+		if (runtime_initialized.is_set() && !monitors.compile_timing) {
+			_enable_compile_timing();
+		}
+	}
+	return monitors.values[p_monitor];
+}
+
+void JuliaLanguage::_pace_gc() {
+	int64_t total_bytes = 0;
+	jl_gc_get_total_bytes(&total_bytes);
+	int64_t frame_allocated = total_bytes - gc_pacing.last_total_bytes;
+	gc_pacing.last_total_bytes = total_bytes;
+	// A collection during the frame (e.g. after the heap passed its limit) counts as the last one, as if the whole frame
+	// allocated after it.
+	uint64_t collection_count = gc_pause_count.get();
+	if (collection_count != gc_pacing.last_collection_count) {
+		gc_pacing.last_collection_count = collection_count;
+		gc_pacing.allocated_since_collection = 0;
+	}
+	gc_pacing.allocated_since_collection += frame_allocated;
+	if (gc_pacing.allocated_since_collection <= 0) {
+		return;
+	}
+
+	jl_gc_collection_t collection;
+	if (gc_pacing.heap_limit > 0 && jl_gc_live_bytes() + gc_pacing.allocated_since_collection > gc_pacing.heap_limit) {
+		collection = JL_GC_FULL;
+	} else {
+		// Collect the young generation at the last frame boundary before the pause is predicted to exceed the budget,
+		// assuming the next frame allocates as much as this one.
+		double predicted_usec = double(gc_pacing.allocated_since_collection + frame_allocated) * gc_pacing.usec_per_byte;
+		if (predicted_usec <= gc_pacing.frame_budget_usec) {
+			return;
+		}
+		collection = JL_GC_INCREMENTAL;
+	}
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	jl_gc_collect(collection);
+	uint64_t pause_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	if (collection == JL_GC_INCREMENTAL) {
+		double usec_per_byte = double(pause_usec) / double(gc_pacing.allocated_since_collection);
+		gc_pacing.usec_per_byte = 0.75 * gc_pacing.usec_per_byte + 0.25 * usec_per_byte;
+	}
+	gc_pacing.allocated_since_collection = 0;
+	gc_pacing.last_collection_count = gc_pause_count.get();
+	jl_gc_get_total_bytes(&gc_pacing.last_total_bytes);
+}
+
+void JuliaLanguage::_update_gc_heap_limit() {
+	int64_t heap_limit_total_bytes = INT64_MAX;
+	if (gc_pacing.heap_limit > 0) {
+		heap_limit_total_bytes = gc_pacing.last_total_bytes + MAX(gc_pacing.heap_limit - jl_gc_live_bytes() - gc_pacing.allocated_since_collection, int64_t(0));
+	}
+	gc_pacing.heap_limit_total_bytes.set(heap_limit_total_bytes);
+	gc_pacing.over_heap_limit.clear();
+}
+
+void JuliaLanguage::_collect_over_heap_limit() {
+	if (gc_pacing.over_heap_limit.is_set()) {
+		// Another thread collected already, and collection isn't deferred anymore, so Julia collects as usual.
+		return;
+	}
+	gc_pacing.over_heap_limit.set();
+	// NOTE: This does nothing while another thread defers collection, but that thread's next callback won't.
+	jl_gc_collect(JL_GC_FULL);
+}
+
+void JuliaLanguage::_loader_thread_func(void *p_userdata) {
+	JuliaLanguage *language = (JuliaLanguage *)p_userdata;
+	// Initializing the runtime makes the thread Julia's primary thread, which should not be a thread of the engine's
+	// pools, so it's done here rather than on the thread which requested the job.
+	language->initialize_runtime();
+	adopt_current_thread();
+
+	while (true) {
+		language->loader.semaphore.wait();
+
+		language->loader.mutex.lock();
+		if (language->loader.jobs.is_empty()) {
+			// Only posted without a job when the thread should exit.
+			language->loader.mutex.unlock();
+			break;
+		}
+		LoaderJob *job = language->loader.jobs.front()->get();
+		language->loader.jobs.pop_front();
+		language->loader.mutex.unlock();
+
+		job->function(job->userdata);
+		job->done.post();
+	}
+}
+
+void JuliaLanguage::run_on_loader_thread(void (*p_function)(void *), void *p_userdata) {
+	LoaderJob job;
+	job.function = p_function;
+	job.userdata = p_userdata;
+
+	{
+		MutexLock lock(loader.mutex);
+		ERR_FAIL_COND_MSG(loader.exit, "The Julia loader thread was already stopped.");
+		if (!loader.thread.is_started()) {
+			loader.thread.start(&JuliaLanguage::_loader_thread_func, this);
+		}
+		loader.jobs.push_back(&job);
+	}
+	loader.semaphore.post();
+
+	JuliaGCSafeScope gc_safe_scope;
+	job.done.wait();
+}
+
+void JuliaLanguage::_stop_loader_thread() {
+	{
+		MutexLock lock(loader.mutex);
+		loader.exit = true;
+		if (!loader.thread.is_started()) {
+			return;
+		}
+	}
+	loader.semaphore.post();
+
+	JuliaGCSafeScope gc_safe_scope;
+	loader.thread.wait_to_finish();
+}
+
+void JuliaLanguage::_start_sampling() {
+	ERR_FAIL_COND(sampling.running);
+	ERR_FAIL_NULL_MSG(runtime_functions.start_sampling, "The Julia package Godot.jl does not support sampling profiles");
+
+	jl_call1(runtime_functions.start_sampling, jl_box_float64(sampling.interval_msec / 1000.0));
+	if (jl_exception_occurred()) {
+		ERR_FAIL_MSG(String("Failed to start the Julia sampling profiler: ") + julia_exception_string());
+	}
+	sampling.running = true;
+}
+
+void JuliaLanguage::_stop_sampling() {
+	if (!sampling.running) {
+		return;
+	}
+	sampling.running = false;
+
+	String path = ProjectSettings::get_singleton()->globalize_path(sampling.output_path);
+	jl_value_t *julia_path = jl_cstr_to_string(path.utf8().get_data());
+	JL_GC_PUSH1(&julia_path);
+	jl_value_t *stack_count = jl_call1(runtime_functions.stop_sampling, julia_path);
+	JL_GC_POP();
+	if (jl_exception_occurred()) {
+		ERR_FAIL_MSG("Failed to write the Julia sampling profile to " + path + ": " + julia_exception_string());
+	}
+	print_line(vformat("Wrote the Julia sampling profile (%d distinct stacks) to %s", jl_unbox_int64(stack_count), path));
 }
 
 void JuliaLanguage::frame() {
+	LocalVector<Ref<JuliaScript>> scripts;
+	{
+		MutexLock lock(mutex);
+		for (SelfList<JuliaScript> *E = script_list.first(); E; E = E->next()) {
+			// Scripts without a reference yet have no instances, and a script which is being destroyed yields a null Ref.
+			if (E->self()->is_referenced()) {
+				Ref<JuliaScript> script(E->self());
+				if (script.is_valid()) {
+					scripts.push_back(script);
+				}
+			}
+		}
+
+#ifdef DEBUG_ENABLED
+		if (profiling.is_set()) {
+			profile_lock.lock();
+			for (SelfList<JuliaScript> *E = script_list.first(); E; E = E->next()) {
+				JuliaScript::StateRef state = E->self()->_get_state();
+				if (!state.is_valid()) {
+					continue;
+				}
+				for (KeyValue<StringName, JuliaScript::Function> &F : state->functions) {
+					JuliaScript::Function::Profile &profile = F.value.profile;
+					profile.last_frame_call_count = profile.frame_call_count;
+					profile.last_frame_self_time = profile.frame_self_time;
+					profile.last_frame_total_time = profile.frame_total_time;
+					profile.frame_call_count = 0;
+					profile.frame_self_time = 0;
+					profile.frame_total_time = 0;
+				}
+			}
+			profile_lock.unlock();
+		}
+#endif
+	}
+
+	// Create the Julia instances that were not needed during the frame, e.g. those of nodes outside the scene tree.
+	// This runs the scripts' new() functions, so it's done without the lock, which constructing or destroying a script
+	// on another thread takes.
+	for (const Ref<JuliaScript> &script : scripts) {
+		script->create_pending_instances();
+	}
+
+	if (!runtime_initialized.is_set()) {
+		return;
+	}
+	JuliaThreadScope thread_scope;
+
+	if (monitors.registered) {
+		_sample_monitors();
+	}
+
+	if (gc_pacing.enabled) {
+		_pace_gc();
+		_update_gc_heap_limit();
+	}
 }
 
 bool JuliaLanguage::handles_global_class_type(const String &p_type) const {
@@ -192,6 +774,25 @@ JuliaLanguage::JuliaLanguage() {
 	ERR_FAIL_COND_MSG(singleton, "Julia singleton already exists.");
 	singleton = this;
 	string_names._script_source = "script/source";
+
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "julia/runtime/sysimage_path", PROPERTY_HINT_GLOBAL_FILE, "*.so,*.dll,*.dylib"), "");
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "julia/runtime/threads", PROPERTY_HINT_RANGE, "0,256,1,or_greater"), 1);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "julia/runtime/optimization_level", PROPERTY_HINT_RANGE, "0,3,1"), 2);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "julia/runtime/compile_mode", PROPERTY_HINT_ENUM, "Yes,No,All,Min"), 0);
+	GLOBAL_DEF("julia/gc/pacing_enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "julia/gc/frame_budget_msec", PROPERTY_HINT_RANGE, "0,100,0.1,or_greater"), 2.0);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "julia/gc/heap_limit_mb", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), 1024);
+	GLOBAL_DEF("julia/compilation/deferred_loading", false);
+	GLOBAL_DEF("julia/compilation/cache_scripts", false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "julia/compilation/cache_path", PROPERTY_HINT_DIR), "user://julia_cache");
+	GLOBAL_DEF("julia/compilation/warm_up_callbacks", false);
+	GLOBAL_DEF("julia/compilation/report_hitches", true);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "julia/compilation/hitch_threshold_msec", PROPERTY_HINT_RANGE, "0,100,0.1,or_greater"), 1.0);
+	GLOBAL_DEF("julia/export/build_sysimage", false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "julia/export/precompile_statements_path", PROPERTY_HINT_FILE, "*.jl"), "res://julia_precompile.jl");
+	GLOBAL_DEF("julia/profiler/sampling_enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "julia/profiler/sampling_interval_msec", PROPERTY_HINT_RANGE, "0.01,100,0.01,or_greater"), 1.0);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "julia/profiler/sampling_output_path", PROPERTY_HINT_SAVE_FILE, "*.folded"), "user://julia_samples.folded");
 }
 
 JuliaLanguage::~JuliaLanguage() {
@@ -2,13 +2,151 @@
 #define JULIA_LANGUAGE_H
 
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
 #include "core/typedefs.h"
 
+#include <julia.h>
+
+class JuliaScript;
+
+// The sysimage which the export plugin builds, and which the runtime loads when it's next to the executable.
+#define JULIA_SYSIMAGE_BASENAME "julia_sysimage"
+
 class JuliaLanguage : public ScriptLanguage {
 	GDCLASS(JuliaLanguage, ScriptLanguage);
 
+	friend class JuliaScript;
+
 	static JuliaLanguage *singleton;
 
+	Mutex mutex;
+	SelfList<JuliaScript>::List script_list;
+
+	// The Julia runtime is initialized when it's first needed, e.g. when the first script is loaded.
+	SafeFlag runtime_initialized;
+	Mutex runtime_mutex;
+	LocalVector<CharString> runtime_options;
+	CharString runtime_bindir;
+	CharString runtime_sysimage_path;
+
+	// Scripts which are loaded from threads unknown to the Julia runtime are evaluated on this thread, which is adopted
+	// by the runtime when it starts, or initializes the runtime if it's the first to need it.
+	struct LoaderJob {
+		void (*function)(void *) = nullptr;
+		void *userdata = nullptr;
+		Semaphore done;
+	};
+
+	struct {
+		Thread thread;
+		Mutex mutex;
+		Semaphore semaphore;
+		List<LoaderJob *> jobs;
+		bool exit = false;
+	} loader;
+
+	static void _loader_thread_func(void *p_userdata);
+	void _stop_loader_thread();
+
+	// Serializes loading Godot.jl, which may happen on the main thread and on the loader thread.
+	Mutex godot_module_mutex;
+	bool _load_godot_module();
+
+	// Serializes evaluating scripts into Main, which may happen on the main thread and on the loader thread.
+	Mutex evaluation_mutex;
+
+	// Julia's garbage collection is deferred during script callbacks and run at frame boundaries instead: a collection of
+	// the young generation (which Julia calls JL_GC_INCREMENTAL, though it isn't incremental) within the frame budget, or
+	// a full collection if the heap would pass the heap limit. If the heap passes the limit during a frame (e.g. a level
+	// load), collection is not deferred anymore until the frame ends.
+	struct {
+		bool enabled = false;
+		uint64_t frame_budget_usec = 0;
+		int64_t heap_limit = 0;
+
+		int64_t last_total_bytes = 0;
+		int64_t allocated_since_collection = 0;
+		uint64_t last_collection_count = 0;
+		// The estimated duration of a young-generation collection per allocated byte, measured as collections happen.
+		double usec_per_byte = 0.001;
+
+		// The value of jl_gc_get_total_bytes at which the heap passes the limit, checked when a callback returns.
+		SafeNumeric<int64_t> heap_limit_total_bytes{ INT64_MAX };
+		SafeFlag over_heap_limit;
+	} gc_pacing;
+
+	void _pace_gc();
+	void _update_gc_heap_limit();
+	void _collect_over_heap_limit();
+
+	// Deferring the evaluation of scripts until their first use, caching their native code on disk, compiling the engine callbacks ahead of their first
+	// call, and reporting calls which compiled anyway.
+	struct {
+		bool deferred_loading = false;
+		bool cache_scripts = false;
+		String cache_path;
+		bool warm_up_callbacks = false;
+		bool report_hitches = false;
+		uint64_t hitch_threshold_nsec = 0;
+	} compilation;
+
+	// Julia's sampling profiler, which runs from when Godot.jl is loaded until the language is finished.
+	struct {
+		bool enabled = false;
+		bool running = false;
+		double interval_msec = 1.0;
+		String output_path;
+	} sampling;
+
+	void _start_sampling();
+	void _stop_sampling();
+
+	// Whether JuliaScriptInstance::callp records the timings of the script functions for the script profiler. Read without
+	// a lock by the threads calling scripts.
+	SafeFlag profiling;
+
+	// Custom monitors of the Performance singleton, sampled once per frame.
+	enum Monitor {
+		MONITOR_HEAP_SIZE,
+		MONITOR_ALLOCATED_BYTES,
+		MONITOR_GC_PAUSES,
+		MONITOR_GC_PAUSE_TIME,
+		MONITOR_COMPILE_TIME,
+		MONITOR_MAX,
+	};
+
+	static SafeNumeric<uint64_t> gc_pause_count;
+	static SafeNumeric<uint64_t> gc_pause_usec;
+	static uint64_t gc_pause_start_usec;
+
+	static void _gc_pre_callback(int p_full);
+	static void _gc_post_callback(int p_full);
+
+	struct {
+		bool registered = false;
+		int64_t last_total_bytes = 0;
+		uint64_t last_gc_pause_count = 0;
+		uint64_t last_gc_pause_usec = 0;
+		uint64_t last_compile_time_nsec = 0;
+		// Measuring compile time slows down compilation, so release builds only do it from when the compile time monitor is
+		// first read. Debug builds always do, which also lets them report compile hitches.
+		bool compile_time_read = false;
+		bool compile_timing = false;
+		double values[MONITOR_MAX] = {};
+	} monitors;
+
+	void _register_monitors();
+	void _unregister_monitors();
+	void _sample_monitors();
+	void _enable_compile_timing();
+	double _get_monitor(int p_monitor);
+
 protected:
 	static void _bind_methods();
 
@@ -21,6 +159,61 @@ public:
 		StringName _script_source;
 	} string_names;
 
+	// The Julia package Godot.jl, loaded when the first script is reloaded.
+	jl_module_t *godot_module = nullptr;
+	jl_module_t *godot_runtime_module = nullptr;
+
+	// Helper functions from the Godot.Runtime module.
+	struct {
+		jl_function_t *script_functions = nullptr;
+		jl_function_t *callback_cfunction = nullptr;
+		jl_function_t *new_instances = nullptr;
+		jl_function_t *warm_up_callback = nullptr;
+		jl_function_t *load_cached_module = nullptr;
+		jl_function_t *load_baked_module = nullptr;
+		jl_function_t *build_sysimage = nullptr;
+		jl_function_t *start_sampling = nullptr;
+		jl_function_t *stop_sampling = nullptr;
+	} runtime_functions;
+
+	// Initializes the Julia runtime with the options of the project settings, if it isn't initialized yet.
+	bool initialize_runtime();
+	_FORCE_INLINE_ bool is_runtime_initialized() const { return runtime_initialized.is_set(); }
+
+	// Makes the current thread known to the Julia runtime, if it isn't yet. Threads known to the runtime wait in a
+	// GC-safe state while they run engine code, so that they never hold up a collection started by another thread;
+	// see JuliaThreadScope for running Julia code.
+	_FORCE_INLINE_ static void adopt_current_thread() {
+		if (unlikely(!jl_get_current_task())) {
+			jl_adopt_thread();
+			jl_gc_safe_enter(jl_get_current_task()->ptls);
+		}
+	}
+
+	// Guards the profiles of script functions, which may be updated on several threads at once while the profiler reads or
+	// resets them.
+	SpinLock profile_lock;
+
+	bool load_godot_module();
+
+	// Runs p_function on the loader thread, and waits for it to return.
+	void run_on_loader_thread(void (*p_function)(void *), void *p_userdata);
+	_FORCE_INLINE_ bool is_loader_thread() const { return loader.thread.is_started() && Thread::get_caller_id() == loader.thread.get_id(); }
+
+	_FORCE_INLINE_ bool is_gc_deferred() const { return gc_pacing.enabled && !gc_pacing.over_heap_limit.is_set(); }
+	// Collects if the heap passed the limit while collection was deferred, and stops deferring it until the frame ends.
+	_FORCE_INLINE_ void check_gc_heap_limit() {
+		int64_t total_bytes = 0;
+		jl_gc_get_total_bytes(&total_bytes);
+		if (unlikely(total_bytes > gc_pacing.heap_limit_total_bytes.get())) {
+			_collect_over_heap_limit();
+		}
+	}
+	_FORCE_INLINE_ bool is_profiling() const { return profiling.is_set(); }
+	_FORCE_INLINE_ bool is_deferred_loading_enabled() const { return compilation.deferred_loading; }
+	_FORCE_INLINE_ bool is_reporting_compile_hitches() const { return compilation.report_hitches; }
+	_FORCE_INLINE_ uint64_t get_compile_hitch_threshold_nsec() const { return compilation.hitch_threshold_nsec; }
+
 	String get_name() const override;
 
 	/* LANGUAGE FUNCTIONS */
@@ -105,4 +298,79 @@ public:
 	virtual ~JuliaLanguage();
 };
 
+// Formats a Julia exception with showerror, e.g. for an error message. Must be called on a thread running Julia code.
+String julia_exception_string(jl_value_t *p_exception);
+
+// Formats the exception thrown by the last call into Julia on this thread.
+_FORCE_INLINE_ String julia_exception_string() {
+	return julia_exception_string(jl_exception_occurred());
+}
+
+// Defers Julia's garbage collection for the lifetime of the scope, if GC pacing is enabled (and the heap didn't pass its
+// limit during the frame).
+class JuliaGCDeferScope {
+	int gc_was_enabled = -1;
+
+public:
+	_FORCE_INLINE_ JuliaGCDeferScope() {
+		if (JuliaLanguage::get_singleton()->is_gc_deferred()) {
+			gc_was_enabled = jl_gc_enable(0);
+		}
+	}
+
+	_FORCE_INLINE_ ~JuliaGCDeferScope() {
+		if (gc_was_enabled != -1) {
+			jl_gc_enable(gc_was_enabled);
+			if (gc_was_enabled) {
+				// The outermost scope, after which a collection can run.
+				JuliaLanguage::get_singleton()->check_gc_heap_limit();
+			}
+		}
+	}
+};
+
+// Lets the current thread run Julia code for the lifetime of the scope: adopts it into the Julia runtime if needed, and
+// leaves the GC-safe state in which the threads known to the runtime run engine code.
+class JuliaThreadScope {
+	jl_ptls_t ptls = nullptr;
+	int8_t gc_state = 0;
+
+public:
+	_FORCE_INLINE_ JuliaThreadScope() {
+		JuliaLanguage::adopt_current_thread();
+		ptls = jl_get_current_task()->ptls;
+		gc_state = jl_gc_unsafe_enter(ptls);
+	}
+
+	_FORCE_INLINE_ ~JuliaThreadScope() {
+		jl_gc_unsafe_leave(ptls, gc_state);
+	}
+};
+
+// Marks the current thread as safe for Julia's garbage collection for the lifetime of the scope, for a thread which
+// blocks (e.g. waiting for another thread) without running Julia code. Otherwise a collection started by another Julia
+// thread would wait for it. Does nothing on threads which are not known to the Julia runtime.
+class JuliaGCSafeScope {
+	jl_ptls_t ptls = nullptr;
+	int8_t gc_state = 0;
+
+public:
+	_FORCE_INLINE_ JuliaGCSafeScope() {
+		if (!jl_is_initialized()) {
+			return;
+		}
+		jl_task_t *task = jl_get_current_task();
+		if (task) {
+			ptls = task->ptls;
+			gc_state = jl_gc_safe_enter(ptls);
+		}
+	}
+
+	_FORCE_INLINE_ ~JuliaGCSafeScope() {
+		if (ptls) {
+			jl_gc_safe_leave(ptls, gc_state);
+		}
+	}
+};
+
 #endif // JULIA_LANGUAGE_H
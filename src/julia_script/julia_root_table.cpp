@@ -0,0 +1,88 @@
+#include "julia_root_table.h"
+
+#include <julia_gcext.h>
+
+Mutex JuliaRootTable::mutex;
+SelfList<JuliaRootTable>::List JuliaRootTable::tables;
+bool JuliaRootTable::root_scanner_registered = false;
+
+void JuliaRootTable::_scan_roots(int p_full) {
+	// NOTE: This runs during a collection. The threads which run engine code are in a GC-safe state rather than stopped
+	// at a safepoint, so they may still be rooting or unrooting values.
+	MutexLock lock(mutex);
+	jl_ptls_t ptls = jl_current_task->ptls;
+	for (SelfList<JuliaRootTable> *E = tables.first(); E; E = E->next()) {
+		const LocalVector<jl_value_t *> &slots = E->self()->slots;
+		for (uint32_t i = 0; i < slots.size(); i++) {
+			if (slots[i]) {
+				jl_gc_mark_queue_obj(ptls, slots[i]);
+			}
+		}
+	}
+}
+
+void JuliaRootTable::_reserve(uint32_t p_count) {
+	// NOTE: Must be called with the mutex locked.
+	if (!root_scanner_registered) {
+		jl_gc_set_cb_root_scanner(_scan_roots, 1);
+		root_scanner_registered = true;
+	}
+
+	if (free_slots.size() >= p_count) {
+		return;
+	}
+
+	// Grow geometrically, so that rooting is amortized O(1).
+	uint32_t old_size = slots.size();
+	uint32_t new_size = MAX(old_size * 2, old_size + p_count - free_slots.size());
+	new_size = MAX(new_size, 16u);
+	slots.resize(new_size);
+	for (uint32_t i = new_size; i > old_size; i--) {
+		slots[i - 1] = nullptr;
+		free_slots.push_back(i - 1);
+	}
+}
+
+uint32_t JuliaRootTable::root(jl_value_t *p_value) {
+	MutexLock lock(mutex);
+
+	_reserve(1);
+
+	uint32_t slot = free_slots[free_slots.size() - 1];
+	free_slots.remove_at(free_slots.size() - 1);
+	slots[slot] = p_value;
+	return slot;
+}
+
+void JuliaRootTable::root_batch(jl_value_t *const *p_values, uint32_t p_count, uint32_t *r_slots) {
+	MutexLock lock(mutex);
+
+	_reserve(p_count);
+
+	uint32_t free_count = free_slots.size();
+	for (uint32_t i = 0; i < p_count; i++) {
+		uint32_t slot = free_slots[free_count - 1 - i];
+		slots[slot] = p_values[i];
+		r_slots[i] = slot;
+	}
+	free_slots.resize(free_count - p_count);
+}
+
+void JuliaRootTable::unroot(uint32_t p_slot) {
+	MutexLock lock(mutex);
+
+	ERR_FAIL_UNSIGNED_INDEX(p_slot, slots.size());
+	slots[p_slot] = nullptr;
+	free_slots.push_back(p_slot);
+}
+
+JuliaRootTable::JuliaRootTable() :
+		table_list(this) {
+	MutexLock lock(mutex);
+	tables.add(&table_list);
+}
+
+JuliaRootTable::~JuliaRootTable() {
+	MutexLock lock(mutex);
+	tables.remove(&table_list);
+}
@@ -0,0 +1,35 @@
+#ifndef JULIA_ROOT_TABLE_H
+#define JULIA_ROOT_TABLE_H
+
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+
+#include <julia.h>
+
+// A table of Julia values kept alive by the engine, with O(1) rooting and unrooting.
+// The slots are scanned by the Julia garbage collector through a root scanner callback.
+class JuliaRootTable {
+	static Mutex mutex;
+	static SelfList<JuliaRootTable>::List tables;
+	static bool root_scanner_registered;
+
+	static void _scan_roots(int p_full);
+
+	void _reserve(uint32_t p_count);
+
+	SelfList<JuliaRootTable> table_list;
+
+	LocalVector<jl_value_t *> slots;
+	LocalVector<uint32_t> free_slots;
+
+public:
+	uint32_t root(jl_value_t *p_value);
+	void root_batch(jl_value_t *const *p_values, uint32_t p_count, uint32_t *r_slots);
+	void unroot(uint32_t p_slot);
+
+	JuliaRootTable();
+	~JuliaRootTable();
+};
+
+#endif // JULIA_ROOT_TABLE_H
@@ -0,0 +1,15 @@
+#ifndef JULIA_RUNTIME_H
+#define JULIA_RUNTIME_H
+
+#include <julia.h>
+
+// Functions which are exported by the Julia runtime, but not declared in julia.h.
+extern "C" {
+JL_DLLEXPORT int64_t jl_gc_live_bytes(void);
+JL_DLLEXPORT void jl_cumulative_compile_timing_enable(void);
+JL_DLLEXPORT void jl_cumulative_compile_timing_disable(void);
+JL_DLLEXPORT uint64_t jl_cumulative_compile_time_ns(void);
+JL_DLLEXPORT const char *jl_get_libdir(void);
+}
+
+#endif // JULIA_RUNTIME_H
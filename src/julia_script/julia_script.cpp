@@ -9,6 +9,7 @@ void JuliaScript::_notification(int p_what) {
 }
 
 void JuliaScript::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("prewarm"), &JuliaScript::prewarm);
 }
 
 bool JuliaScript::_get(const StringName &p_name, Variant &r_ret) const {
@@ -22,7 +23,11 @@ bool JuliaScript::_get(const StringName &p_name, Variant &r_ret) const {
 bool JuliaScript::_set(const StringName &p_name, const Variant &p_value) {
 	if (p_name == JuliaLanguage::get_singleton()->string_names._script_source) {
 		set_source_code(p_value);
-		reload();
+		if (JuliaLanguage::get_singleton()->is_deferred_loading_enabled()) {
+			_defer_reload();
+		} else {
+			reload();
+		}
 		return true;
 	}
 	return false;
@@ -38,7 +43,8 @@ bool JuliaScript::can_instantiate() const {
 #else
 	bool extra_cond = true;
 #endif
-	return valid && extra_cond;
+	_ensure_loaded();
+	return _get_state().is_valid() && extra_cond;
 }
 
 Ref<Script> JuliaScript::get_base_script() const {
@@ -58,15 +64,18 @@ StringName JuliaScript::get_instance_base_type() const {
 }
 
 ScriptInstance *JuliaScript::instance_create(Object *p_this) {
+	_ensure_loaded();
+
 #ifdef DEBUG_ENABLED
-	CRASH_COND(!valid);
+	CRASH_COND(!_get_state().is_valid());
 #endif
 
 	JuliaScriptInstance *instance = memnew(JuliaScriptInstance(Ref<JuliaScript>(this), p_this));
-	if (!instance->julia_instance) {
-		memdelete(instance);
-		// At this point an error message was already printed in the JuliaScriptInstance constructor.
-		return nullptr;
+
+	// The Julia instance is created later, together with the other pending instances, see create_pending_instances.
+	{
+		MutexLock lock(pending_instances_mutex);
+		pending_instances.add(&instance->pending_list);
 	}
 
 	// TODO: Check inheritance.
@@ -76,6 +85,108 @@ ScriptInstance *JuliaScript::instance_create(Object *p_this) {
 	return instance;
 }
 
+void JuliaScript::create_pending_instances() {
+	StateRef state = _get_state();
+	if (!state.is_valid()) {
+		// The instances stay pending, e.g. until the script is reloaded successfully.
+		return;
+	}
+
+	// One batch at a time, so that a caller whose instance is in the batch of another thread waits until it's done,
+	// rather than finding no pending instance.
+	// NOTE: The mutex is recursive, so new() may call the instances of earlier batches, but not those of its own batch.
+	{
+		JuliaGCSafeScope gc_safe_scope;
+		instance_batch_mutex.lock();
+	}
+	_create_instance_batch(state);
+	instance_batch_mutex.unlock();
+}
+
+void JuliaScript::_create_instance_batch(const StateRef &p_state) {
+	// The instances of the batch are moved to a list of their own while their Julia instances are constructed. An
+	// instance which is destroyed meanwhile (e.g. because the script code replaced the script of its owner) removes
+	// itself from that list, so that it doesn't get a Julia instance after the batch.
+	SelfList<JuliaScriptInstance>::List batch;
+	LocalVector<void *> owners;
+	{
+		MutexLock lock(pending_instances_mutex);
+		while (pending_instances.first()) {
+			JuliaScriptInstance *instance = pending_instances.first()->self();
+			pending_instances.remove(&instance->pending_list);
+			batch.add_last(&instance->pending_list);
+			instance->batch_index = owners.size();
+			owners.push_back(instance->owner);
+		}
+	}
+
+	if (owners.is_empty()) {
+		return;
+	}
+
+	JuliaThreadScope thread_scope;
+	JuliaGCDeferScope gc_defer_scope;
+
+	// Construct all Julia instances in one call, wrapping the owners without copying them.
+	jl_value_t *owners_type = jl_apply_array_type((jl_value_t *)jl_voidpointer_type, 1);
+	jl_array_t *julia_owners = jl_ptr_to_array_1d(owners_type, owners.ptr(), owners.size(), 0);
+	jl_value_t *result = nullptr;
+	JL_GC_PUSH2(&julia_owners, &result);
+	result = jl_call3(JuliaLanguage::get_singleton()->runtime_functions.new_instances, p_state->julia_new, (jl_value_t *)p_state->julia_new_param_type, (jl_value_t *)julia_owners);
+	if (jl_exception_occurred()) {
+		JL_GC_POP();
+		// Not retried, since new() may have run for some of the instances already. They fail like those whose new()
+		// threw, so that the error is reported once rather than on every call.
+		{
+			MutexLock lock(pending_instances_mutex);
+			while (batch.first()) {
+				JuliaScriptInstance *instance = batch.first()->self();
+				batch.remove(&instance->pending_list);
+				instance->creation_status.set(JuliaScriptInstance::CREATION_FAILED);
+			}
+		}
+		ERR_FAIL_MSG("Failed to create the instances of Julia script " + get_path() + ": " + julia_exception_string());
+	}
+
+	jl_array_t *julia_instances = (jl_array_t *)jl_get_nth_field(result, 0);
+	jl_array_t *julia_exceptions = (jl_array_t *)jl_get_nth_field(result, 1);
+	for (uint32_t i = 0; i < owners.size(); i++) {
+		jl_value_t *julia_exception = jl_array_ptr_ref(julia_exceptions, i);
+		if (julia_exception != jl_nothing) {
+			ERR_PRINT("Julia script " + get_path() + " module's new() method throws an exception: " + julia_exception_string(julia_exception));
+		}
+	}
+
+	{
+		// The instances which are still in the batch were not destroyed, and can't be until the lock is released.
+		MutexLock lock(pending_instances_mutex);
+		LocalVector<JuliaScriptInstance *> created_instances;
+		LocalVector<jl_value_t *> created_values;
+		while (batch.first()) {
+			JuliaScriptInstance *instance = batch.first()->self();
+			batch.remove(&instance->pending_list);
+			if (jl_array_ptr_ref(julia_exceptions, instance->batch_index) != jl_nothing) {
+				// new() threw, which was reported above.
+				instance->creation_status.set(JuliaScriptInstance::CREATION_FAILED);
+				continue;
+			}
+			created_instances.push_back(instance);
+			created_values.push_back(jl_array_ptr_ref(julia_instances, instance->batch_index));
+		}
+
+		// Rooting to protect from the garbage collector, in one operation for the whole batch.
+		LocalVector<uint32_t> roots;
+		roots.resize(created_values.size());
+		instance_roots.root_batch(created_values.ptr(), created_values.size(), roots.ptr());
+		for (uint32_t i = 0; i < created_instances.size(); i++) {
+			created_instances[i]->julia_instance = created_values[i];
+			created_instances[i]->julia_instance_root = roots[i];
+			created_instances[i]->creation_status.set(JuliaScriptInstance::CREATION_DONE);
+		}
+	}
+	JL_GC_POP();
+}
+
 bool JuliaScript::instance_has(const Object *p_this) const {
 	return false;
 }
@@ -90,22 +201,66 @@ String JuliaScript::get_source_code() const {
 
 void JuliaScript::set_source_code(const String &p_code) {
 	source_code = p_code;
+	source_hash = source_code.hash64();
 }
 
-Error JuliaScript::reload(bool p_keep_state) {
-	valid = false;
-	julia_module = nullptr;
+static JuliaScript::CallbackSignature _get_callback_signature(const StringName &p_name) {
+	if (p_name == SNAME("_ready") || p_name == SNAME("_enter_tree") || p_name == SNAME("_exit_tree")) {
+		return JuliaScript::CALLBACK_SIGNATURE_SELF;
+	}
+	if (p_name == SNAME("_process") || p_name == SNAME("_physics_process")) {
+		return JuliaScript::CALLBACK_SIGNATURE_SELF_FLOAT;
+	}
+	if (p_name == SNAME("_input") || p_name == SNAME("_shortcut_input") || p_name == SNAME("_unhandled_input") || p_name == SNAME("_unhandled_key_input")) {
+		return JuliaScript::CALLBACK_SIGNATURE_SELF_OBJECT;
+	}
+	return JuliaScript::CALLBACK_SIGNATURE_NONE;
+}
+
+void JuliaScript::_load_module_job(void *p_userdata) {
+	LoadModuleJob *job = (LoadModuleJob *)p_userdata;
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	{
+		JuliaGCSafeScope gc_safe_scope;
+		language->evaluation_mutex.lock();
+	}
+	job->error = job->script->_load_module(*job->state);
+	language->evaluation_mutex.unlock();
+}
+
+Error JuliaScript::_load_module(State &r_state) {
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	ERR_FAIL_COND_V_MSG(!language->load_godot_module(), FAILED, "Cannot reload Julia script " + get_path() + " without the Julia package Godot.jl");
 
-	// TODO: Handle reloading requests from threads.
-	ERR_FAIL_COND_V_MSG(Thread::get_caller_id() != Thread::get_main_id(), FAILED, "Tried to reload Julia script " + get_path() + " from a separate thread; this is not supported for now.");
+	JuliaThreadScope thread_scope;
 
-	jl_value_t *julia_module_maybe = jl_eval_string(source_code.utf8().get_data());
+	// Evaluated with the script's path as the file name, so that stack traces and profiles refer to the script's lines.
+	jl_value_t *julia_source = jl_cstr_to_string(source_code.utf8().get_data());
+	jl_value_t *julia_file_name = nullptr;
+	jl_value_t *julia_cache_path = nullptr;
+	jl_value_t *julia_module_maybe = jl_nothing;
+	JL_GC_PUSH4(&julia_source, &julia_file_name, &julia_cache_path, &julia_module_maybe);
+	julia_file_name = jl_cstr_to_string(get_path().utf8().get_data());
+	// The module may have been evaluated already when building the sysimage, see JuliaExportPlugin.
+	julia_module_maybe = jl_call1(language->runtime_functions.load_baked_module, julia_source);
 	if (jl_exception_occurred()) {
-		// None of these allocate, so a gc-root (JL_GC_PUSH) is not necessary.
-		jl_value_t *exception_str = jl_call2(jl_get_function(jl_base_module, "sprint"),
-				jl_get_function(jl_base_module, "showerror"),
-				jl_exception_occurred());
-		ERR_FAIL_V_MSG(FAILED, "Julia script " + get_path() + " throws an exception: " + jl_string_ptr(exception_str));
+		WARN_PRINT("Failed to load Julia script " + get_path() + " from the sysimage, evaluating it instead: " + julia_exception_string());
+		julia_module_maybe = jl_nothing;
+	}
+	if (julia_module_maybe == jl_nothing && language->compilation.cache_scripts) {
+		julia_cache_path = jl_cstr_to_string(language->compilation.cache_path.utf8().get_data());
+		julia_module_maybe = jl_call3(language->runtime_functions.load_cached_module, julia_source, julia_file_name, julia_cache_path);
+		if (jl_exception_occurred()) {
+			WARN_PRINT("Failed to load Julia script " + get_path() + " from the cache, evaluating it instead: " + julia_exception_string());
+			julia_module_maybe = jl_nothing;
+		}
+	}
+	if (julia_module_maybe == jl_nothing) {
+		julia_module_maybe = jl_call3(jl_get_function(jl_base_module, "include_string"), (jl_value_t *)jl_main_module, julia_source, julia_file_name);
+	}
+	JL_GC_POP();
+	if (jl_exception_occurred()) {
+		ERR_FAIL_V_MSG(FAILED, "Julia script " + get_path() + " throws an exception: " + julia_exception_string());
 	}
 
 	ERR_FAIL_COND_V_MSG(!jl_is_module(julia_module_maybe), FAILED, "Julia script " + get_path() + " is not a module");
@@ -128,19 +283,155 @@ Error JuliaScript::reload(bool p_keep_state) {
 	jl_value_t *julia_new_param_type_maybe = jl_svec_data(julia_new_parameters)[1];
 	ERR_FAIL_COND_V_MSG(!jl_is_structtype(julia_new_param_type_maybe), FAILED, "Julia script " + get_path() + " module's 'new' method should take a struct type as its argument");
 
-	valid = true;
-	julia_module = (jl_module_t *)julia_module_maybe;
-	julia_new = julia_new_maybe;
-	julia_new_param_type = (jl_datatype_t *)julia_new_param_type_maybe;
+	jl_value_t *julia_functions = jl_call1(language->runtime_functions.script_functions, julia_module_maybe);
+	if (jl_exception_occurred()) {
+		ERR_FAIL_V_MSG(FAILED, "Failed to list the functions of Julia script " + get_path() + ": " + julia_exception_string());
+	}
+
+	// NOTE: The functions themselves are rooted by the script module, and building the table doesn't allocate in Julia.
+	for (size_t i = 0; i < jl_array_len(julia_functions); i++) {
+		jl_value_t *entry = jl_array_ptr_ref(julia_functions, i);
+		jl_sym_t *name = (jl_sym_t *)jl_get_nth_field(entry, 0);
+		jl_array_t *argument_names = (jl_array_t *)jl_get_nth_field(entry, 2);
+
+		Function function;
+		function.julia_function = jl_get_nth_field(entry, 1);
+		function.info.name = String::utf8(jl_symbol_name(name));
+		// Read in place, since jl_get_nth_field would box the line.
+		function.line = *(int64_t *)((char *)entry + jl_field_offset((jl_datatype_t *)jl_typeof(entry), 3));
+#ifdef DEBUG_ENABLED
+		// The format expected by the profiler: "path::line::function".
+		function.profile.signature = get_path() + "::" + itos(function.line) + "::" + function.info.name;
+#endif
+		function.info.return_val.usage |= PROPERTY_USAGE_NIL_IS_VARIANT;
+		for (size_t j = 0; j < jl_array_len(argument_names); j++) {
+			jl_sym_t *argument_name = (jl_sym_t *)jl_array_ptr_ref(argument_names, j);
+			function.info.arguments.push_back(PropertyInfo(Variant::NIL, String::utf8(jl_symbol_name(argument_name)), PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT));
+		}
+		r_state.functions.insert(function.info.name, function);
+	}
+
+	// Compile specialized entry points for the engine callbacks with known signatures.
+	for (KeyValue<StringName, Function> &E : r_state.functions) {
+		CallbackSignature callback_signature = _get_callback_signature(E.key);
+		if (callback_signature == CALLBACK_SIGNATURE_NONE) {
+			continue;
+		}
+		jl_value_t *callback_cfunction = jl_call3(language->runtime_functions.callback_cfunction, julia_module_maybe,
+				(jl_value_t *)jl_symbol(String(E.key).utf8().get_data()), jl_box_int64(callback_signature));
+		if (jl_exception_occurred()) {
+			WARN_PRINT("Failed to compile the entry point of Julia method " + E.key + " in " + get_path() + ", falling back to the generic call: " + julia_exception_string());
+			continue;
+		}
+		E.value.callback_cfunction = jl_unbox_voidpointer(callback_cfunction);
+		if (E.value.callback_cfunction) {
+			E.value.callback_signature = callback_signature;
+		}
+	}
+
+	if (language->compilation.warm_up_callbacks) {
+		// Compile the engine callbacks now, rather than on their first call in the middle of the game.
+		for (KeyValue<StringName, Function> &E : r_state.functions) {
+			CallbackSignature callback_signature = _get_callback_signature(E.key);
+			if (callback_signature == CALLBACK_SIGNATURE_NONE) {
+				continue;
+			}
+			jl_value_t *warm_up_args[4] = { julia_module_maybe, (jl_value_t *)jl_symbol(String(E.key).utf8().get_data()), jl_box_int64(callback_signature), julia_new_param_type_maybe };
+			jl_value_t *compiled = jl_call(language->runtime_functions.warm_up_callback, warm_up_args, 4);
+			if (jl_exception_occurred()) {
+				WARN_PRINT("Failed to warm up Julia method " + E.key + " in " + get_path() + ": " + julia_exception_string());
+				continue;
+			}
+			if (!jl_unbox_bool(compiled)) {
+				print_verbose("Julia method " + E.key + " in " + get_path() + " could not be fully compiled ahead of its first call.");
+			}
+			E.value.warmed_up = true;
+		}
+	}
+
+	r_state.julia_module = (jl_module_t *)julia_module_maybe;
+	r_state.julia_new = julia_new_maybe;
+	r_state.julia_new_param_type = (jl_datatype_t *)julia_new_param_type_maybe;
 
 	// Rooting to protect from the garbage collector.
-	jl_binding_t *b_module = jl_get_binding_wr(jl_main_module, julia_module->name, 1);
-	jl_checked_assignment(b_module, jl_main_module, julia_module->name, (jl_value_t *)julia_module);
+	jl_binding_t *b_module = jl_get_binding_wr(jl_main_module, r_state.julia_module->name, 1);
+	jl_checked_assignment(b_module, jl_main_module, r_state.julia_module->name, (jl_value_t *)r_state.julia_module);
+
+	return OK;
+}
+
+JuliaScript::StateRef JuliaScript::_get_state() const {
+	state_lock.lock();
+	State *current_state = state;
+	if (current_state) {
+		current_state->refcount.ref();
+	}
+	state_lock.unlock();
+	return StateRef(current_state);
+}
 
-    jl_sym_t *sym_instances = jl_symbol("#GODOT_INSTANCES#");
-	jl_binding_t *b_instances = jl_get_binding_wr(julia_module, sym_instances, 1);
-	julia_instances = jl_eval_string("IdDict()");
-	jl_checked_assignment(b_instances, julia_module, sym_instances, julia_instances);
+void JuliaScript::_publish_state(State *p_state) {
+	state_lock.lock();
+	State *old_state = state;
+	state = p_state;
+	state_lock.unlock();
+	// Freed when the last caller which uses it is done.
+	StateRef old_state_ref(old_state);
+}
+
+void JuliaScript::_defer_reload() {
+	if (_get_state().is_valid() && source_hash == loaded_source_hash) {
+		// The module of the same source was already evaluated.
+		return;
+	}
+	reload_deferred.set();
+}
+
+void JuliaScript::_reload_deferred() {
+	{
+		JuliaGCSafeScope gc_safe_scope;
+		deferred_reload_mutex.lock();
+	}
+	// Another thread may have reloaded the script while this one was waiting.
+	if (reload_deferred.is_set()) {
+		reload();
+	}
+	deferred_reload_mutex.unlock();
+}
+
+Error JuliaScript::prewarm() {
+	_ensure_loaded();
+	return _get_state().is_valid() ? OK : FAILED;
+}
+
+Error JuliaScript::reload(bool p_keep_state) {
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	uint64_t reloaded_source_hash = source_hash;
+
+	LoadModuleJob job;
+	job.script = this;
+	job.state = memnew(State);
+	if (Thread::get_caller_id() == Thread::get_main_id() || language->is_loader_thread()) {
+		_load_module_job(&job);
+	} else {
+		// Threads of the engine (e.g. those of ResourceLoader) are not known to the Julia runtime, so the module is
+		// evaluated on the loader thread instead.
+		language->run_on_loader_thread(&JuliaScript::_load_module_job, &job);
+	}
+
+	// The new state is published at once, after the module was evaluated and validated.
+	// A deferred reload is only marked as done afterwards (with release ordering), so that the threads which use the
+	// script in the meantime wait for it in _reload_deferred rather than seeing no state or the previous one.
+	if (job.error != OK) {
+		memdelete(job.state);
+		_publish_state(nullptr);
+		loaded_source_hash = reloaded_source_hash;
+		reload_deferred.clear();
+		return job.error;
+	}
+	_publish_state(job.state);
+	loaded_source_hash = reloaded_source_hash;
+	reload_deferred.clear();
 
 	// TODO: Update script class info.
 
@@ -167,12 +458,28 @@ PropertyInfo JuliaScript::get_class_category() const {
 
 #endif
 
+bool JuliaScript::is_valid() const {
+	_ensure_loaded();
+	return _get_state().is_valid();
+}
+
 bool JuliaScript::has_method(const StringName &p_method) const {
-	return false;
+	_ensure_loaded();
+	StateRef state = _get_state();
+	return state.is_valid() && state->functions.has(p_method);
 }
 
 MethodInfo JuliaScript::get_method_info(const StringName &p_method) const {
-	return MethodInfo();
+	_ensure_loaded();
+	StateRef state = _get_state();
+	if (!state.is_valid()) {
+		return MethodInfo();
+	}
+	const Function *function = state->functions.getptr(p_method);
+	if (!function) {
+		return MethodInfo();
+	}
+	return function->info;
 }
 
 ScriptLanguage *JuliaScript::get_language() const {
@@ -191,6 +498,14 @@ bool JuliaScript::get_property_default_value(const StringName &p_property, Varia
 }
 
 void JuliaScript::get_script_method_list(List<MethodInfo> *p_list) const {
+	_ensure_loaded();
+	StateRef state = _get_state();
+	if (!state.is_valid()) {
+		return;
+	}
+	for (const KeyValue<StringName, Function> &E : state->functions) {
+		p_list->push_back(E.value.info);
+	}
 }
 
 void JuliaScript::get_script_property_list(List<PropertyInfo> *p_list) const {
@@ -200,6 +515,22 @@ const Variant JuliaScript::get_rpc_config() const {
 	return Variant();
 }
 
+JuliaScript::JuliaScript() :
+		script_list(this) {
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	MutexLock lock(language->mutex);
+	language->script_list.add(&script_list);
+}
+
+JuliaScript::~JuliaScript() {
+	JuliaLanguage *language = JuliaLanguage::get_singleton();
+	{
+		MutexLock lock(language->mutex);
+		language->script_list.remove(&script_list);
+	}
+	_publish_state(nullptr);
+}
+
 /* SCRIPT RESOURCE FORMAT LOADER */
 
 Ref<Resource> ResourceFormatLoaderJuliaScript::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
@@ -215,7 +546,12 @@ Ref<Resource> ResourceFormatLoaderJuliaScript::load(const String &p_path, const
 	julia_script->set_source_code(source_file->get_as_text());
 	julia_script->set_path(p_original_path);
 
-	julia_script->reload();
+	if (JuliaLanguage::get_singleton()->is_deferred_loading_enabled()) {
+		// Evaluated when the script is first used, e.g. when it's first instantiated.
+		julia_script->_defer_reload();
+	} else {
+		julia_script->reload();
+	}
 
 	if (r_error) {
 		*r_error = OK;
@@ -4,6 +4,10 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/safe_refcount.h"
+
+#include "julia_root_table.h"
 
 #include <julia.h>
 
@@ -13,15 +17,136 @@ class JuliaScript : public Script {
 	GDCLASS(JuliaScript, Script);
 
 	friend class JuliaScriptInstance;
+	friend class JuliaLanguage;
+	friend class JuliaFunctionProfileScope;
+	friend class JuliaCompileHitchScope;
+	friend class ResourceFormatLoaderJuliaScript;
+
+public:
+	// Known signatures of engine callbacks, for which a specialized entry point is compiled.
+	// NOTE: These must be kept in sync with the constants in Godot.Runtime.
+	enum CallbackSignature {
+		CALLBACK_SIGNATURE_NONE,
+		CALLBACK_SIGNATURE_SELF, // e.g. _ready(self)
+		CALLBACK_SIGNATURE_SELF_FLOAT, // e.g. _process(self, delta::Float64)
+		CALLBACK_SIGNATURE_SELF_OBJECT, // e.g. _input(self, event)
+	};
+
+private:
+	// A function of the script module that can be called from the engine.
+	struct Function {
+		jl_function_t *julia_function = nullptr;
+		MethodInfo info;
+
+		// The specialized entry point, which returns nothing or the thrown exception. Falls back to jl_call if null.
+		CallbackSignature callback_signature = CALLBACK_SIGNATURE_NONE;
+		void *callback_cfunction = nullptr;
+		// Whether the callback was compiled when the module was loaded, after which its calls report compile hitches.
+		bool warmed_up = false;
+
+		// The line of the first method definition.
+		int line = 0;
+
+#ifdef DEBUG_ENABLED
+		// Recorded by JuliaScriptInstance::callp while the script profiler is running. Times are in microseconds.
+		struct Profile {
+			// Set when the module is loaded, in the format expected by the profiler.
+			StringName signature;
+			uint64_t call_count = 0;
+			uint64_t self_time = 0;
+			uint64_t total_time = 0;
+			uint64_t frame_call_count = 0;
+			uint64_t frame_self_time = 0;
+			uint64_t frame_total_time = 0;
+			uint64_t last_frame_call_count = 0;
+			uint64_t last_frame_self_time = 0;
+			uint64_t last_frame_total_time = 0;
+		} profile;
+#endif
+	};
+
+	// The result of evaluating the source code, which is not modified once reload() published it (except for the
+	// profiles of the functions). The callers keep the state they use alive with a StateRef, so that a reload on
+	// another thread never frees it under them.
+	struct State {
+		SafeRefCount refcount;
+		jl_module_t *julia_module = nullptr;
+		jl_function_t *julia_new = nullptr;
+		jl_datatype_t *julia_new_param_type = nullptr;
+		// Built by _load_module, so that looking up a method doesn't require a round trip to Julia.
+		HashMap<StringName, Function> functions;
+
+		State() { refcount.init(); }
+	};
+
+	class StateRef {
+		State *state = nullptr;
+
+	public:
+		_FORCE_INLINE_ bool is_valid() const { return state != nullptr; }
+		_FORCE_INLINE_ State *operator->() const { return state; }
+
+		// Takes over a reference which was already counted.
+		_FORCE_INLINE_ explicit StateRef(State *p_state) :
+				state(p_state) {}
+		_FORCE_INLINE_ StateRef(StateRef &&p_other) :
+				state(p_other.state) { p_other.state = nullptr; }
+		StateRef(const StateRef &) = delete;
+		StateRef &operator=(const StateRef &) = delete;
+		_FORCE_INLINE_ ~StateRef() {
+			if (state && state->refcount.unref()) {
+				memdelete(state);
+			}
+		}
+	};
+
+	// Guards the pointer to the current state and taking a reference to it, which is short enough for a spin lock.
+	mutable SpinLock state_lock;
+	State *state = nullptr;
+
+	StateRef _get_state() const;
+	void _publish_state(State *p_state);
 
 	String source_code;
-	bool valid = false;
+	uint64_t source_hash = 0;
 	bool tool = false;
 
-	jl_module_t *julia_module = nullptr;
-	jl_function_t *julia_new = nullptr;
-	jl_datatype_t *julia_new_param_type = nullptr;
-	jl_value_t *julia_instances = nullptr;
+	// In deferred loading mode, the module is evaluated on first use rather than when the script is loaded. The flag
+	// stays set until the state was published, and the threads which see it set wait for deferred_reload_mutex.
+	SafeFlag reload_deferred;
+	Mutex deferred_reload_mutex;
+	uint64_t loaded_source_hash = 0;
+
+	void _defer_reload();
+	_FORCE_INLINE_ void _ensure_loaded() const {
+		if (unlikely(reload_deferred.is_set())) {
+			const_cast<JuliaScript *>(this)->_reload_deferred();
+		}
+	}
+	void _reload_deferred();
+
+	// Keeps the Julia instances alive while their JuliaScriptInstance exists.
+	JuliaRootTable instance_roots;
+
+	// Instances whose Julia instance is constructed lazily, in one batch, when one of them is first used.
+	Mutex pending_instances_mutex;
+	SelfList<JuliaScriptInstance>::List pending_instances;
+	// Held while a batch is constructed, which runs the new() function of the script.
+	Mutex instance_batch_mutex;
+
+	void _create_instance_batch(const StateRef &p_state);
+
+	SelfList<JuliaScript> script_list;
+
+	struct LoadModuleJob {
+		JuliaScript *script = nullptr;
+		State *state = nullptr;
+		Error error = FAILED;
+	};
+
+	// Evaluates the source code into a new state. Must be called on a thread known to the Julia runtime.
+	Error _load_module(State &r_state);
+	static void _load_module_job(void *p_userdata);
 
 protected:
 	void _notification(int p_what);
@@ -57,11 +182,16 @@ public:
 	PropertyInfo get_class_category() const override;
 #endif // TOOLS_ENABLED
 
+	// Constructs the Julia instances which are pending, or waits until another thread has constructed them.
+	void create_pending_instances();
+
+	Error prewarm();
+
 	bool has_method(const StringName &p_method) const override;
 	MethodInfo get_method_info(const StringName &p_method) const override;
 
 	bool is_tool() const override { return tool; }
-	bool is_valid() const override { return valid; }
+	bool is_valid() const override;
 	bool is_abstract() const override { return false; };
 
 	ScriptLanguage *get_language() const override;
@@ -84,7 +214,8 @@ public:
 
 	const Variant get_rpc_config() const override;
 
-	JuliaScript() {}
+	JuliaScript();
+	~JuliaScript();
 };
 
 class ResourceFormatLoaderJuliaScript : public ResourceFormatLoader {
@@ -1,9 +1,106 @@
 #include "julia_script_instance.h"
 
 #include "julia_language.h"
+#include "julia_runtime.h"
 #include "julia_script.h"
 #include "julia_variant.h"
 
+#include "core/os/os.h"
+
+#ifdef DEBUG_ENABLED
+// Records a call of a script function while the script profiler is running.
+// The time spent in nested calls of script functions counts towards the total time, but not the self time.
+class JuliaFunctionProfileScope {
+	static thread_local JuliaFunctionProfileScope *current;
+
+	JuliaScript::Function *function = nullptr;
+	JuliaFunctionProfileScope *parent = nullptr;
+	uint64_t start_usec = 0;
+	uint64_t nested_usec = 0;
+
+public:
+	_FORCE_INLINE_ JuliaFunctionProfileScope(JuliaScript::Function *p_function) {
+		if (likely(!JuliaLanguage::get_singleton()->is_profiling())) {
+			return;
+		}
+		function = p_function;
+		parent = current;
+		current = this;
+		start_usec = OS::get_singleton()->get_ticks_usec();
+	}
+
+	_FORCE_INLINE_ ~JuliaFunctionProfileScope() {
+		if (likely(!function)) {
+			return;
+		}
+		uint64_t total_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		uint64_t self_usec = total_usec > nested_usec ? total_usec - nested_usec : 0;
+
+		SpinLock &profile_lock = JuliaLanguage::get_singleton()->profile_lock;
+		profile_lock.lock();
+		JuliaScript::Function::Profile &profile = function->profile;
+		profile.call_count++;
+		profile.self_time += self_usec;
+		profile.total_time += total_usec;
+		profile.frame_call_count++;
+		profile.frame_self_time += self_usec;
+		profile.frame_total_time += total_usec;
+		profile_lock.unlock();
+
+		current = parent;
+		if (parent) {
+			parent->nested_usec += total_usec;
+		}
+	}
+};
+
+thread_local JuliaFunctionProfileScope *JuliaFunctionProfileScope::current = nullptr;
+
+// Reports a call of a script function which spent more than the threshold compiling Julia code (excluding nested calls
+// of script functions), i.e. a hitch which warming up the callbacks at reload didn't prevent.
+// NOTE: The compile time is measured for all threads, so compilation on other threads can be attributed to the call.
+class JuliaCompileHitchScope {
+	static thread_local JuliaCompileHitchScope *current;
+
+	const JuliaScriptInstance *instance = nullptr;
+	const StringName *method = nullptr;
+	JuliaCompileHitchScope *parent = nullptr;
+	uint64_t start_nsec = 0;
+	uint64_t nested_nsec = 0;
+
+public:
+	_FORCE_INLINE_ JuliaCompileHitchScope(const JuliaScriptInstance *p_instance, const StringName &p_method, const JuliaScript::Function *p_function) {
+		// Callbacks which were not warmed up compile on their first call anyway.
+		if (likely(!p_function->warmed_up || !JuliaLanguage::get_singleton()->is_reporting_compile_hitches())) {
+			return;
+		}
+		instance = p_instance;
+		method = &p_method;
+		parent = current;
+		current = this;
+		start_nsec = jl_cumulative_compile_time_ns();
+	}
+
+	_FORCE_INLINE_ ~JuliaCompileHitchScope() {
+		if (likely(!instance)) {
+			return;
+		}
+		uint64_t total_nsec = jl_cumulative_compile_time_ns() - start_nsec;
+		uint64_t self_nsec = total_nsec > nested_nsec ? total_nsec - nested_nsec : 0;
+		if (unlikely(self_nsec > JuliaLanguage::get_singleton()->get_compile_hitch_threshold_nsec())) {
+			WARN_PRINT(vformat("Julia method %s in %s spent %.2f ms compiling.", *method, instance->get_script()->get_path(), double(self_nsec) / 1000000.0));
+		}
+
+		current = parent;
+		if (parent) {
+			parent->nested_nsec += total_nsec;
+		}
+	}
+};
+
+thread_local JuliaCompileHitchScope *JuliaCompileHitchScope::current = nullptr;
+#endif
+
 bool JuliaScriptInstance::set(const StringName &p_name, const Variant &p_value) {
 	return false;
 }
@@ -34,19 +131,82 @@ void JuliaScriptInstance::get_property_state(List<Pair<StringName, Variant>> &st
 }
 
 void JuliaScriptInstance::get_method_list(List<MethodInfo> *p_list) const {
+	if (creation_status.get() == CREATION_FAILED) {
+		return;
+	}
+	script->get_script_method_list(p_list);
 }
 
 bool JuliaScriptInstance::has_method(const StringName &p_method) const {
-	return false;
+	return creation_status.get() != CREATION_FAILED && script->has_method(p_method);
+}
+
+bool JuliaScriptInstance::_create() {
+	script->create_pending_instances();
+	return creation_status.get() == CREATION_DONE;
 }
 
 Variant JuliaScriptInstance::callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	jl_function_t *function = jl_get_function(script->julia_module, String(p_method).utf8().get_data());
+	if (unlikely(!_is_created())) {
+		// E.g. new() threw, which was reported when it did. Like for an owner without a script instance, the owner's own
+		// methods are called instead.
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
+		return Variant();
+	}
+
+	// Keeps the functions alive, even if the script is reloaded on another thread during the call.
+	JuliaScript::StateRef state = script->_get_state();
+	JuliaScript::Function *function = state.is_valid() ? state->functions.getptr(p_method) : nullptr;
 	if (!function) {
 		r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
 		return Variant();
 	}
 
+#ifdef DEBUG_ENABLED
+	JuliaFunctionProfileScope profile_scope(function);
+	JuliaCompileHitchScope compile_hitch_scope(this, p_method, function);
+#endif
+
+	JuliaThreadScope thread_scope;
+	JuliaGCDeferScope gc_defer_scope;
+
+	if (function->callback_cfunction) {
+		// Fast path: call the specialized entry point directly, without boxing the arguments where possible.
+		bool called = false;
+		jl_value_t *julia_exception = jl_nothing;
+		switch (function->callback_signature) {
+			case JuliaScript::CALLBACK_SIGNATURE_SELF: {
+				if (p_argcount == 0) {
+					julia_exception = ((jl_value_t * (*)(jl_value_t *)) function->callback_cfunction)(julia_instance);
+					called = true;
+				}
+			} break;
+			case JuliaScript::CALLBACK_SIGNATURE_SELF_FLOAT: {
+				if (p_argcount == 1 && p_args[0]->get_type() == Variant::FLOAT) {
+					julia_exception = ((jl_value_t * (*)(jl_value_t *, double)) function->callback_cfunction)(julia_instance, p_args[0]->operator double());
+					called = true;
+				}
+			} break;
+			case JuliaScript::CALLBACK_SIGNATURE_SELF_OBJECT: {
+				if (p_argcount == 1) {
+					jl_value_t *argument = julia_value_from_variant(p_args[0]);
+					JL_GC_PUSH1(&argument);
+					julia_exception = ((jl_value_t * (*)(jl_value_t *, jl_value_t *)) function->callback_cfunction)(julia_instance, argument);
+					JL_GC_POP();
+					called = true;
+				}
+			} break;
+			default:
+				break;
+		}
+		if (called) {
+			if (julia_exception != jl_nothing) {
+				ERR_FAIL_V_MSG(Variant(), "Julia method " + p_method + " in " + script->get_path() + " throws an exception: " + julia_exception_string(julia_exception));
+			}
+			return Variant();
+		}
+	}
+
 	// Put arguments on the stack and call the function.
 	jl_value_t **args = (jl_value_t **)alloca(sizeof(jl_value_t *) * (p_argcount + 1));
 	JL_GC_PUSHARGS(args, p_argcount + 1);
@@ -54,15 +214,11 @@ Variant JuliaScriptInstance::callp(const StringName &p_method, const Variant **p
 	for (int i = 0; i < p_argcount; i++) {
 		args[i + 1] = julia_value_from_variant(p_args[i]);
 	}
-	jl_value_t *julia_ret = jl_call(function, args, p_argcount + 1);
+	jl_value_t *julia_ret = jl_call(function->julia_function, args, p_argcount + 1);
 	JL_GC_POP();
 
 	if (jl_exception_occurred()) {
-		// None of these allocate, so a gc-root (JL_GC_PUSH) is not necessary.
-		jl_value_t *exception_str = jl_call2(jl_get_function(jl_base_module, "sprint"),
-				jl_get_function(jl_base_module, "showerror"),
-				jl_exception_occurred());
-		ERR_FAIL_V_MSG(Variant(), "Julia method " + p_method + " in " + script->get_path() + " throws an exception: " + jl_string_ptr(exception_str));
+		ERR_FAIL_V_MSG(Variant(), "Julia method " + p_method + " in " + script->get_path() + " throws an exception: " + julia_exception_string());
 	}
 
 	return variant_from_julia_value(julia_ret);
@@ -98,26 +254,18 @@ ScriptLanguage *JuliaScriptInstance::get_language() {
 }
 
 JuliaScriptInstance::JuliaScriptInstance(const Ref<JuliaScript> &p_script, Object *p_owner) :
-		script(p_script), owner(p_owner) {
-	jl_value_t *base_obj = jl_new_struct((jl_datatype_t *)p_script->julia_new_param_type,
-			jl_box_voidpointer((void *)owner));
-	julia_instance = jl_call1(script->julia_new, base_obj);
-	if (jl_exception_occurred()) {
-		// None of these allocate, so a gc-root (JL_GC_PUSH) is not necessary.
-		jl_value_t *exception_str = jl_call2(jl_get_function(jl_base_module, "sprint"),
-				jl_get_function(jl_base_module, "showerror"),
-				jl_exception_occurred());
-		ERR_FAIL_MSG("Julia script " + script->get_path() + " module's new() method throws an exception: " + jl_string_ptr(exception_str));
-		// This invalid JuliaScriptInstance will be deleted in JuliaScript::instance_create.
-	}
-
-	// Rooting to protect from the garbage collector.
-	jl_function_t *setindex = jl_get_function(jl_base_module, "setindex!");
-	jl_call3(setindex, script->julia_instances, julia_instance, julia_instance);
+		script(p_script), owner(p_owner), pending_list(this) {
 }
 
 JuliaScriptInstance::~JuliaScriptInstance() {
+	{
+		// Also cancels the construction of the Julia instance, if it's in a batch.
+		MutexLock lock(script->pending_instances_mutex);
+		pending_list.remove_from_list();
+	}
+
 	// Unrooting to release to the garbage collector.
-	jl_function_t *delete_shriek = jl_get_function(jl_base_module, "delete!");
-	jl_call2(delete_shriek, script->julia_instances, julia_instance);
+	if (creation_status.get() == CREATION_DONE) {
+		script->instance_roots.unroot(julia_instance_root);
+	}
 }
@@ -2,6 +2,8 @@
 #define JULIA_SCRIPT_INSTANCE_H
 
 #include "core/object/script_language.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/self_list.h"
 
 #include <julia.h>
 
@@ -12,7 +14,29 @@ class JuliaScriptInstance : ScriptInstance {
 
 	Ref<JuliaScript> script;
 	Object *owner = nullptr;
-	jl_value_t *julia_instance;
+
+	enum CreationStatus {
+		CREATION_PENDING,
+		CREATION_DONE,
+		// new() threw, so the instance behaves as if the owner had no script instance.
+		CREATION_FAILED,
+	};
+
+	// Set (with release ordering) once the Julia instance was constructed by JuliaScript::create_pending_instances,
+	// so that julia_instance can be read without a lock once it's CREATION_DONE.
+	SafeNumeric<uint32_t> creation_status;
+	jl_value_t *julia_instance = nullptr;
+	uint32_t julia_instance_root = 0;
+
+	// In the script's list of pending instances, or in a batch of JuliaScript::create_pending_instances while its
+	// Julia instance is constructed.
+	SelfList<JuliaScriptInstance> pending_list;
+	uint32_t batch_index = 0;
+
+	_FORCE_INLINE_ bool _is_created() {
+		return likely(creation_status.get() == CREATION_DONE) || _create();
+	}
+	bool _create();
 
 public:
 	bool set(const StringName &p_name, const Variant &p_value) override;
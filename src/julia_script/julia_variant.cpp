@@ -0,0 +1,346 @@
+#include "julia_variant.h"
+
+#include "core/object/class_db.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant_internal.h"
+
+// How a Julia value of a given type is converted to a Variant.
+enum JuliaConversion {
+	JULIA_CONVERSION_NOTHING,
+	JULIA_CONVERSION_BOOL,
+	JULIA_CONVERSION_INT8,
+	JULIA_CONVERSION_INT16,
+	JULIA_CONVERSION_INT32,
+	JULIA_CONVERSION_INT64,
+	JULIA_CONVERSION_UINT8,
+	JULIA_CONVERSION_UINT16,
+	JULIA_CONVERSION_UINT32,
+	JULIA_CONVERSION_UINT64,
+	JULIA_CONVERSION_FLOAT32,
+	JULIA_CONVERSION_FLOAT64,
+	JULIA_CONVERSION_STRING,
+	JULIA_CONVERSION_GODOT_STRING,
+	JULIA_CONVERSION_STRING_NAME,
+	JULIA_CONVERSION_VARIANT,
+	// A Godot.PackedArray view of the elements of a packed array.
+	JULIA_CONVERSION_PACKED_ARRAY,
+	// The bytes of the value are the bytes of the Variant's data.
+	JULIA_CONVERSION_BITS,
+};
+
+struct JuliaConversionInfo {
+	JuliaConversion conversion = JULIA_CONVERSION_NOTHING;
+	Variant::Type variant_type = Variant::NIL;
+};
+
+static struct {
+	bool initialized = false;
+
+	// Indexed by Variant::Type; non-null for types whose data is copied bit for bit into a Julia struct.
+	jl_datatype_t *bits_types[Variant::VARIANT_MAX] = {};
+	// Indexed by Variant::Type; non-null for packed arrays whose elements are viewed by a Godot.PackedArray.
+	jl_datatype_t *packed_array_types[Variant::VARIANT_MAX] = {};
+
+	jl_datatype_t *godot_string_type = nullptr;
+	jl_datatype_t *string_name_type = nullptr;
+	jl_datatype_t *variant_type = nullptr;
+	jl_datatype_t *godot_object_type = nullptr;
+
+	jl_function_t *destroy_string = nullptr;
+	jl_function_t *destroy_string_name = nullptr;
+	jl_function_t *destroy_variant = nullptr;
+
+	HashMap<jl_datatype_t *, JuliaConversionInfo> conversions;
+
+	// The Julia struct for each engine class, filled in once for all the classes of ClassDB.
+	HashMap<StringName, jl_datatype_t *> object_types;
+} julia_types;
+
+static jl_datatype_t *_get_godot_type(jl_module_t *p_godot_module, const char *p_name) {
+	jl_value_t *type = jl_get_global(p_godot_module, jl_symbol(p_name));
+	ERR_FAIL_COND_V_MSG(!type || !jl_is_datatype(type), nullptr, vformat("The Julia package Godot.jl does not define the type %s.", p_name));
+	return (jl_datatype_t *)type;
+}
+
+static jl_datatype_t *_find_object_type(jl_module_t *p_godot_module, const StringName &p_class_name) {
+	jl_datatype_t *const *known_type = julia_types.object_types.getptr(p_class_name);
+	if (known_type) {
+		return *known_type;
+	}
+
+	jl_datatype_t *type = nullptr;
+	jl_value_t *value = jl_get_global(p_godot_module, jl_symbol(String(p_class_name).utf8().get_data()));
+	if (!value || !jl_is_datatype(value) || !jl_is_concrete_type(value)) {
+		// Singletons are represented by a struct with a suffix, because their name is taken by a module.
+		value = jl_get_global(p_godot_module, jl_symbol((String(p_class_name) + "Instance").utf8().get_data()));
+	}
+	if (value && jl_is_datatype(value) && jl_is_concrete_type(value)) {
+		type = (jl_datatype_t *)value;
+	} else {
+		// Classes that are not exposed (or not bound) are represented by their closest exposed ancestor.
+		StringName parent_class_name = ClassDB::get_parent_class_nocheck(p_class_name);
+		if (parent_class_name != StringName()) {
+			type = _find_object_type(p_godot_module, parent_class_name);
+		}
+	}
+	julia_types.object_types.insert(p_class_name, type);
+	return type;
+}
+
+void julia_variant_initialize_types(jl_module_t *p_godot_module) {
+	if (julia_types.initialized) {
+		return;
+	}
+
+	struct BitsType {
+		Variant::Type variant_type;
+		const char *name;
+		size_t size;
+	};
+	const BitsType bits_types[] = {
+		{ Variant::VECTOR2, "Vector2", sizeof(Vector2) },
+		{ Variant::VECTOR2I, "Vector2i", sizeof(Vector2i) },
+		{ Variant::RECT2, "Rect2", sizeof(Rect2) },
+		{ Variant::RECT2I, "Rect2i", sizeof(Rect2i) },
+		{ Variant::VECTOR3, "Vector3", sizeof(Vector3) },
+		{ Variant::VECTOR3I, "Vector3i", sizeof(Vector3i) },
+		{ Variant::TRANSFORM2D, "Transform2D", sizeof(Transform2D) },
+		{ Variant::VECTOR4, "Vector4", sizeof(Vector4) },
+		{ Variant::VECTOR4I, "Vector4i", sizeof(Vector4i) },
+		{ Variant::PLANE, "Plane", sizeof(Plane) },
+		{ Variant::QUATERNION, "Quaternion", sizeof(Quaternion) },
+		{ Variant::AABB, "AABB", sizeof(AABB) },
+		{ Variant::BASIS, "Basis", sizeof(Basis) },
+		{ Variant::TRANSFORM3D, "Transform3D", sizeof(Transform3D) },
+		{ Variant::PROJECTION, "Projection", sizeof(Projection) },
+		{ Variant::COLOR, "Color", sizeof(Color) },
+		{ Variant::RID, "RID", sizeof(RID) },
+	};
+	for (const BitsType &bits_type : bits_types) {
+		jl_datatype_t *type = _get_godot_type(p_godot_module, bits_type.name);
+		if (!type) {
+			continue;
+		}
+		ERR_CONTINUE_MSG(!jl_isbits(type) || jl_datatype_size(type) != bits_type.size,
+				vformat("The Julia type %s does not have the memory layout of the Variant type.", bits_type.name));
+		julia_types.bits_types[bits_type.variant_type] = type;
+		julia_types.conversions.insert(type, { JULIA_CONVERSION_BITS, bits_type.variant_type });
+	}
+
+	struct PackedArrayType {
+		Variant::Type variant_type;
+		const char *name;
+	};
+	const PackedArrayType packed_array_types[] = {
+		{ Variant::PACKED_BYTE_ARRAY, "PackedByteArray" },
+		{ Variant::PACKED_INT32_ARRAY, "PackedInt32Array" },
+		{ Variant::PACKED_INT64_ARRAY, "PackedInt64Array" },
+		{ Variant::PACKED_FLOAT32_ARRAY, "PackedFloat32Array" },
+		{ Variant::PACKED_FLOAT64_ARRAY, "PackedFloat64Array" },
+		{ Variant::PACKED_VECTOR2_ARRAY, "PackedVector2Array" },
+		{ Variant::PACKED_VECTOR3_ARRAY, "PackedVector3Array" },
+		{ Variant::PACKED_COLOR_ARRAY, "PackedColorArray" },
+		{ Variant::PACKED_VECTOR4_ARRAY, "PackedVector4Array" },
+	};
+	for (const PackedArrayType &packed_array_type : packed_array_types) {
+		jl_datatype_t *type = _get_godot_type(p_godot_module, packed_array_type.name);
+		if (!type) {
+			continue;
+		}
+		julia_types.packed_array_types[packed_array_type.variant_type] = type;
+		julia_types.conversions.insert(type, { JULIA_CONVERSION_PACKED_ARRAY, packed_array_type.variant_type });
+	}
+
+	julia_types.godot_string_type = _get_godot_type(p_godot_module, "GodotString");
+	julia_types.string_name_type = _get_godot_type(p_godot_module, "StringName");
+	julia_types.variant_type = _get_godot_type(p_godot_module, "Variant");
+	julia_types.godot_object_type = _get_godot_type(p_godot_module, "GodotObject");
+
+	julia_types.destroy_string = jl_get_function(p_godot_module, "destroy_string");
+	julia_types.destroy_string_name = jl_get_function(p_godot_module, "destroy_string_name");
+	julia_types.destroy_variant = jl_get_function(p_godot_module, "destroy_variant");
+
+	julia_types.conversions.insert(jl_nothing_type, { JULIA_CONVERSION_NOTHING, Variant::NIL });
+	julia_types.conversions.insert(jl_bool_type, { JULIA_CONVERSION_BOOL, Variant::BOOL });
+	julia_types.conversions.insert(jl_int8_type, { JULIA_CONVERSION_INT8, Variant::INT });
+	julia_types.conversions.insert(jl_int16_type, { JULIA_CONVERSION_INT16, Variant::INT });
+	julia_types.conversions.insert(jl_int32_type, { JULIA_CONVERSION_INT32, Variant::INT });
+	julia_types.conversions.insert(jl_int64_type, { JULIA_CONVERSION_INT64, Variant::INT });
+	julia_types.conversions.insert(jl_uint8_type, { JULIA_CONVERSION_UINT8, Variant::INT });
+	julia_types.conversions.insert(jl_uint16_type, { JULIA_CONVERSION_UINT16, Variant::INT });
+	julia_types.conversions.insert(jl_uint32_type, { JULIA_CONVERSION_UINT32, Variant::INT });
+	julia_types.conversions.insert(jl_uint64_type, { JULIA_CONVERSION_UINT64, Variant::INT });
+	julia_types.conversions.insert(jl_float32_type, { JULIA_CONVERSION_FLOAT32, Variant::FLOAT });
+	julia_types.conversions.insert(jl_float64_type, { JULIA_CONVERSION_FLOAT64, Variant::FLOAT });
+	julia_types.conversions.insert(jl_string_type, { JULIA_CONVERSION_STRING, Variant::STRING });
+	if (julia_types.godot_string_type) {
+		julia_types.conversions.insert(julia_types.godot_string_type, { JULIA_CONVERSION_GODOT_STRING, Variant::STRING });
+	}
+	if (julia_types.string_name_type) {
+		julia_types.conversions.insert(julia_types.string_name_type, { JULIA_CONVERSION_STRING_NAME, Variant::STRING_NAME });
+	}
+	if (julia_types.variant_type) {
+		julia_types.conversions.insert(julia_types.variant_type, { JULIA_CONVERSION_VARIANT, Variant::NIL });
+	}
+
+	// Resolved for all classes at once, so that converting an object never calls into Julia or takes a lock.
+	List<StringName> classes;
+	ClassDB::get_class_list(&classes);
+	for (const StringName &class_name : classes) {
+		_find_object_type(p_godot_module, class_name);
+	}
+
+	julia_types.initialized = true;
+}
+
+static jl_datatype_t *_get_object_type(const Object *p_object) {
+	// NOTE: The table is not modified after initialization, so reading it doesn't need a lock.
+	StringName class_name = p_object->get_class_name();
+	while (class_name != StringName()) {
+		jl_datatype_t *const *type = julia_types.object_types.getptr(class_name);
+		if (type) {
+			return *type;
+		}
+		// A class registered after Godot.jl was loaded is represented by its closest ancestor in the table.
+		class_name = ClassDB::get_parent_class_nocheck(class_name);
+	}
+	return nullptr;
+}
+
+static jl_value_t *_new_with_finalizer(jl_datatype_t *p_type, jl_function_t *p_finalizer) {
+	jl_value_t *value = jl_new_struct_uninit(p_type);
+	JL_GC_PUSH1(&value);
+	jl_gc_add_finalizer(value, p_finalizer);
+	JL_GC_POP();
+	return value;
+}
+
+jl_value_t *julia_value_from_variant(const Variant *p_variant) {
+	Variant::Type type = p_variant->get_type();
+
+	jl_datatype_t *bits_type = julia_types.bits_types[type];
+	if (bits_type) {
+		return jl_new_bits((jl_value_t *)bits_type, VariantInternal::get_opaque_pointer_const(p_variant));
+	}
+
+	jl_datatype_t *packed_array_type = julia_types.packed_array_types[type];
+	if (packed_array_type && julia_types.variant_type) {
+		// The view shares the elements with the engine's array, so they are not copied.
+		jl_value_t *variant = _new_with_finalizer(julia_types.variant_type, julia_types.destroy_variant);
+		memnew_placement(jl_data_ptr(variant), Variant(*p_variant));
+		JL_GC_PUSH1(&variant);
+		jl_value_t *value = jl_call1((jl_value_t *)packed_array_type, variant);
+		JL_GC_POP();
+		ERR_FAIL_NULL_V_MSG(value, jl_nothing, "Could not create a Godot.PackedArray.");
+		return value;
+	}
+
+	switch (type) {
+		case Variant::NIL: {
+			return jl_nothing;
+		}
+		case Variant::BOOL: {
+			return jl_box_bool(*VariantInternal::get_bool(p_variant));
+		}
+		case Variant::INT: {
+			return jl_box_int64(*VariantInternal::get_int(p_variant));
+		}
+		case Variant::FLOAT: {
+			return jl_box_float64(*VariantInternal::get_float(p_variant));
+		}
+		case Variant::STRING: {
+			CharString utf8 = VariantInternal::get_string(p_variant)->utf8();
+			return jl_pchar_to_string(utf8.get_data(), utf8.length());
+		}
+		case Variant::STRING_NAME: {
+			if (!julia_types.string_name_type) {
+				return jl_nothing;
+			}
+			jl_value_t *value = _new_with_finalizer(julia_types.string_name_type, julia_types.destroy_string_name);
+			memnew_placement(jl_data_ptr(value), StringName(*VariantInternal::get_string_name(p_variant)));
+			return value;
+		}
+		case Variant::OBJECT: {
+			Object *object = p_variant->get_validated_object();
+			if (!object) {
+				return jl_nothing;
+			}
+			jl_datatype_t *object_type = _get_object_type(object);
+			if (!object_type) {
+				return jl_nothing;
+			}
+			return jl_new_bits((jl_value_t *)object_type, &object);
+		}
+		default: {
+			// Everything else is passed as an opaque Godot.Variant.
+			if (!julia_types.variant_type) {
+				return jl_nothing;
+			}
+			jl_value_t *value = _new_with_finalizer(julia_types.variant_type, julia_types.destroy_variant);
+			memnew_placement(jl_data_ptr(value), Variant(*p_variant));
+			return value;
+		}
+	}
+}
+
+Variant variant_from_julia_value(jl_value_t *p_value) {
+	jl_datatype_t *type = (jl_datatype_t *)jl_typeof(p_value);
+
+	const JuliaConversionInfo *info = julia_types.conversions.getptr(type);
+	if (!info) {
+		if (julia_types.godot_object_type && jl_subtype((jl_value_t *)type, (jl_value_t *)julia_types.godot_object_type)) {
+			return Variant(*(Object **)jl_data_ptr(p_value));
+		}
+		// Values without a Variant counterpart (e.g. Julia structs or tuples) are nil, without an error, since callbacks
+		// often return their last expression without meaning to.
+		return Variant();
+	}
+
+	switch (info->conversion) {
+		case JULIA_CONVERSION_NOTHING:
+			return Variant();
+		case JULIA_CONVERSION_BOOL:
+			return Variant((bool)jl_unbox_bool(p_value));
+		case JULIA_CONVERSION_INT8:
+			return Variant(jl_unbox_int8(p_value));
+		case JULIA_CONVERSION_INT16:
+			return Variant(jl_unbox_int16(p_value));
+		case JULIA_CONVERSION_INT32:
+			return Variant(jl_unbox_int32(p_value));
+		case JULIA_CONVERSION_INT64:
+			return Variant(jl_unbox_int64(p_value));
+		case JULIA_CONVERSION_UINT8:
+			return Variant(jl_unbox_uint8(p_value));
+		case JULIA_CONVERSION_UINT16:
+			return Variant(jl_unbox_uint16(p_value));
+		case JULIA_CONVERSION_UINT32:
+			return Variant(jl_unbox_uint32(p_value));
+		case JULIA_CONVERSION_UINT64:
+			return Variant(jl_unbox_uint64(p_value));
+		case JULIA_CONVERSION_FLOAT32:
+			return Variant(jl_unbox_float32(p_value));
+		case JULIA_CONVERSION_FLOAT64:
+			return Variant(jl_unbox_float64(p_value));
+		case JULIA_CONVERSION_STRING:
+			return Variant(String::utf8(jl_string_ptr(p_value), jl_string_len(p_value)));
+		case JULIA_CONVERSION_GODOT_STRING:
+			return Variant(*(const String *)jl_data_ptr(p_value));
+		case JULIA_CONVERSION_STRING_NAME:
+			return Variant(*(const StringName *)jl_data_ptr(p_value));
+		case JULIA_CONVERSION_VARIANT:
+			return *(const Variant *)jl_data_ptr(p_value);
+		case JULIA_CONVERSION_PACKED_ARRAY: {
+			// The engine shares the elements from now on, so the next write from Julia has to check whether to copy them.
+			jl_set_nth_field(p_value, 3, jl_false);
+			return *(const Variant *)jl_data_ptr(jl_get_nth_field_noalloc(p_value, 0));
+		}
+		case JULIA_CONVERSION_BITS: {
+			Variant variant;
+			VariantInternal::initialize(&variant, info->variant_type);
+			memcpy(VariantInternal::get_opaque_pointer(&variant), jl_data_ptr(p_value), jl_datatype_size(type));
+			return variant;
+		}
+	}
+
+	return Variant();
+}
@@ -7,7 +7,10 @@
 #include "julia_script.h"
 
 #ifdef TOOLS_ENABLED
+#include "editor/editor_node.h"
+#include "editor/export/editor_export.h"
 #include "editor/julia_bindings_generator.h"
+#include "editor/julia_export_plugin.h"
 #endif
 
 #include <julia.h>
@@ -16,12 +19,25 @@ JuliaLanguage *script_language_jl = nullptr;
 Ref<ResourceFormatLoaderJuliaScript> resource_loader_jl;
 Ref<ResourceFormatSaverJuliaScript> resource_saver_jl;
 
+#ifdef TOOLS_ENABLED
+static void _editor_init() {
+	Ref<JuliaExportPlugin> export_plugin;
+	export_plugin.instantiate();
+	EditorExport::get_singleton()->add_export_plugin(export_plugin);
+}
+#endif
+
 void initialize_julia_script_module(ModuleInitializationLevel p_level) {
-	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
+#ifdef TOOLS_ENABLED
+	if (p_level == MODULE_INITIALIZATION_LEVEL_EDITOR) {
+		EditorNode::add_init_callback(_editor_init);
 		return;
 	}
+#endif
 
-	jl_init();
+	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
+		return;
+	}
 
 	GDREGISTER_CLASS(JuliaScript);
 #ifdef TOOLS_ENABLED
@@ -55,5 +71,8 @@ void uninitialize_julia_script_module(ModuleInitializationLevel p_level) {
 	ResourceSaver::remove_resource_format_saver(resource_saver_jl);
 	resource_saver_jl.unref();
 
-	jl_atexit_hook(0);
+	// The runtime is only initialized once it was needed, see JuliaLanguage::initialize_runtime.
+	if (jl_is_initialized()) {
+		jl_atexit_hook(0);
+	}
 }